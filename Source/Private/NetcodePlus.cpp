@@ -1,6 +1,11 @@
 // NetcodePlus.cpp
 #include "NetcodePlus.h"
 #include "Modules/ModuleManager.h"
+#include "TeamArenaCollisionRoster.h"
+#include "NetcodePlusStats.h"
+#include "NetcodePlusRpcStats.h"
+#include "NetcodePlusAuditLog.h"
+#include "NetcodePlusSessionRecorder.h"
 
 
 
@@ -10,9 +15,18 @@ IMPLEMENT_MODULE(FNetcodePlus, NetcodePlus)
 void FNetcodePlus::StartupModule()
 {
 	UE_LOG(LogLoad, Log, TEXT("netcodeplus loaded"));
+	FTeamArenaCollisionRoster::RegisterWorldDelegates();
+	FNetcodePlusRpcStats::RegisterWorldDelegates();
+	FNetcodePlusAuditLog::RegisterWorldDelegates();
+	FNetcodePlusSessionRecorder::RegisterWorldDelegates();
 }
 
 void FNetcodePlus::ShutdownModule()
 {
+	FTeamArenaCollisionRoster::UnregisterWorldDelegates();
+	FNetcodePlusRpcStats::UnregisterWorldDelegates();
+	FNetcodePlusAuditLog::UnregisterWorldDelegates();
+	FNetcodePlusSessionRecorder::UnregisterWorldDelegates();
+	FNetcodePlusProfiler::StopCsv();
 	UE_LOG(LogLoad, Log, TEXT("netcodeplus unloaded"));
 }
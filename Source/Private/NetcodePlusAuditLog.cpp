@@ -0,0 +1,227 @@
+// NetcodePlusAuditLog.cpp
+
+#include "NetcodePlusAuditLog.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Engine/NetDriver.h"
+
+static TAutoConsoleVariable<int32> CVarAuditLog(
+    TEXT("np.AuditLog"),
+    0,
+    TEXT("Write a binary per-shot hit-registration audit log on the server (Saved/Logs/NetcodePlus/*.npaudit).\n")
+    TEXT("0 = off (default), 1 = on"),
+    ECVF_Default);
+
+#if NETCODEPLUS_DIAGNOSTICS
+static TAutoConsoleVariable<int32> CVarHitDiag(
+    TEXT("np.HitDiag"),
+    0,
+    TEXT("Server hit-registration diagnostics. Costs an O(pawns) rewind scan per unclaimed miss.\n")
+    TEXT("0 = off (default), 1 = near-miss margin and rewind distance in np.AuditLog records,\n")
+    TEXT("2 = also log rejected claims and near misses"),
+    ECVF_Default);
+#endif
+
+/** Queue entry: record header plus the largest payload */
+struct FNPAuditPendingRecord
+{
+    FNPAuditRecordHeader Header;
+    union
+    {
+        FNPAuditShot Shot;
+        FNPAuditWeaponName WeaponName;
+    };
+};
+
+/**
+ * Owns the file. The game thread is the only producer, the writer thread the only consumer,
+ * so the queue runs in SPSC mode and never takes a lock. The thread polls; shots arrive at
+ * refire rate, so there is nothing to gain from waking it per record.
+ */
+class FNetcodePlusAuditWriter : public FRunnable
+{
+public:
+    FNetcodePlusAuditWriter(FArchive* InArchive)
+        : Archive(InArchive)
+        , Thread(nullptr)
+    {
+        Thread = FRunnableThread::Create(this, TEXT("NetcodePlusAuditWriter"), 0, TPri_BelowNormal);
+    }
+
+    virtual ~FNetcodePlusAuditWriter()
+    {
+        if (Thread != nullptr)
+        {
+            Thread->Kill(true);
+            delete Thread;
+        }
+        // Thread is gone; anything queued after its last drain is written here
+        Drain();
+        Archive->Close();
+        delete Archive;
+    }
+
+    void Enqueue(const FNPAuditPendingRecord& Record)
+    {
+        Queue.Enqueue(Record);
+    }
+
+    virtual uint32 Run() override
+    {
+        double LastFlush = FPlatformTime::Seconds();
+        while (!bStopping)
+        {
+            if (!Drain())
+            {
+                FPlatformProcess::Sleep(0.05f);
+            }
+            const double Now = FPlatformTime::Seconds();
+            if (Now - LastFlush > 1.0)
+            {
+                Archive->Flush();
+                LastFlush = Now;
+            }
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopping = true;
+    }
+
+private:
+    FArchive* Archive;
+    FRunnableThread* Thread;
+    FThreadSafeBool bStopping;
+    TQueue<FNPAuditPendingRecord, EQueueMode::Spsc> Queue;
+
+    /** @return true if anything was written */
+    bool Drain()
+    {
+        bool bWrote = false;
+        FNPAuditPendingRecord Record;
+        while (Queue.Dequeue(Record))
+        {
+            Archive->Serialize(&Record.Header, sizeof(Record.Header));
+            Archive->Serialize(&Record.Shot, Record.Header.Size);
+            bWrote = true;
+        }
+        return bWrote;
+    }
+};
+
+FNetcodePlusAuditWriter* FNetcodePlusAuditLog::Writer = nullptr;
+TMap<FName, uint8> FNetcodePlusAuditLog::WeaponIds;
+FDelegateHandle FNetcodePlusAuditLog::WorldCleanupHandle;
+
+bool FNetcodePlusAuditLog::IsEnabled()
+{
+    return CVarAuditLog.GetValueOnGameThread() != 0;
+}
+
+#if NETCODEPLUS_DIAGNOSTICS
+int32 FNetcodePlusAuditLog::GetDiagnosticsLevel()
+{
+    return FMath::Clamp(CVarHitDiag.GetValueOnGameThread(), 0, 2);
+}
+#endif
+
+bool FNetcodePlusAuditLog::Open(UWorld* World)
+{
+    const FString MapName = World->GetMapName();
+    const FString FilePath = FPaths::GameLogDir() / TEXT("NetcodePlus") / FString::Printf(TEXT("Audit-%s-%s.npaudit"), *MapName, *FDateTime::Now().ToString());
+    FArchive* Archive = IFileManager::Get().CreateFileWriter(*FilePath);
+    if (Archive == nullptr)
+    {
+        UE_LOG(LogNet, Warning, TEXT("NetcodePlus: could not write %s, disabling audit log"), *FilePath);
+        CVarAuditLog->Set(0);
+        return false;
+    }
+
+    FNPAuditFileHeader FileHeader;
+    FMemory::Memzero(FileHeader);
+    FileHeader.Magic = NPAUDIT_MAGIC;
+    FileHeader.Version = NPAUDIT_VERSION;
+    FileHeader.HeaderSize = sizeof(FNPAuditFileHeader);
+    FileHeader.StartUnixMs = (uint64)((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+    FileHeader.ServerTickRate = World->GetNetDriver() ? (float)World->GetNetDriver()->NetServerMaxTickRate : 0.f;
+    FCStringAnsi::Strncpy(FileHeader.MapName, TCHAR_TO_ANSI(*MapName), NPAUDIT_NAME_LEN);
+    Archive->Serialize(&FileHeader, sizeof(FileHeader));
+
+    Writer = new FNetcodePlusAuditWriter(Archive);
+    WeaponIds.Reset();
+    UE_LOG(LogNet, Log, TEXT("NetcodePlus: audit log started, %s"), *FilePath);
+    return true;
+}
+
+void FNetcodePlusAuditLog::Close()
+{
+    if (Writer != nullptr)
+    {
+        delete Writer;
+        Writer = nullptr;
+        WeaponIds.Reset();
+    }
+}
+
+void FNetcodePlusAuditLog::RecordShot(UWorld* World, UClass* WeaponClass, FNPAuditShot& Shot)
+{
+    if (!IsEnabled() || World == nullptr || (Writer == nullptr && !Open(World)))
+    {
+        return;
+    }
+
+    // Weapon names go out once per file; shots carry a byte. 255 = everything past the first 255 classes.
+    const FName WeaponName = WeaponClass ? WeaponClass->GetFName() : NAME_None;
+    uint8* ExistingId = WeaponIds.Find(WeaponName);
+    if (ExistingId == nullptr)
+    {
+        const uint8 NewId = (uint8)FMath::Min(WeaponIds.Num(), 255);
+        WeaponIds.Add(WeaponName, NewId);
+        if (NewId < 255)
+        {
+            FNPAuditPendingRecord NameRecord;
+            FMemory::Memzero(NameRecord);
+            NameRecord.Header.Type = NPAuditRecord_WeaponName;
+            NameRecord.Header.Size = sizeof(FNPAuditWeaponName);
+            NameRecord.WeaponName.WeaponId = NewId;
+            FCStringAnsi::Strncpy(NameRecord.WeaponName.Name, TCHAR_TO_ANSI(*WeaponName.ToString()), NPAUDIT_NAME_LEN);
+            Writer->Enqueue(NameRecord);
+        }
+        Shot.WeaponId = NewId;
+    }
+    else
+    {
+        Shot.WeaponId = *ExistingId;
+    }
+
+    FNPAuditPendingRecord ShotRecord;
+    ShotRecord.Header.Type = NPAuditRecord_Shot;
+    ShotRecord.Header.Size = sizeof(FNPAuditShot);
+    ShotRecord.Shot = Shot;
+    Writer->Enqueue(ShotRecord);
+}
+
+void FNetcodePlusAuditLog::RegisterWorldDelegates()
+{
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FNetcodePlusAuditLog::OnWorldCleanup);
+}
+
+void FNetcodePlusAuditLog::UnregisterWorldDelegates()
+{
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    Close();
+}
+
+void FNetcodePlusAuditLog::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    if (World != nullptr && World->IsGameWorld())
+    {
+        Close();
+    }
+}
@@ -0,0 +1,165 @@
+// NetcodePlusNetDiagnostics.cpp
+
+#include "NetcodePlusNetDiagnostics.h"
+#include "TeamArenaPredictionPC.h"
+#include "Engine/Canvas.h"
+#include "Engine/Font.h"
+
+static TAutoConsoleVariable<int32> CVarNetDiag(
+    TEXT("np.NetDiag"),
+    0,
+    TEXT("Show the NetcodePlus net diagnostics overlay (rewind, clock offset, shots, corrections, link batches).\n")
+    TEXT("0 = off (default), 1 = on. Stats are pushed by the server at 1-2 Hz while on."),
+    ECVF_Default);
+
+int32 FNetcodePlusNetDiagnostics::NumSubscribers = 0;
+bool FNetcodePlusNetDiagnostics::bOverlayActive = false;
+
+void FNetcodePlusNetDiagCounters::Reset()
+{
+    FMemory::Memzero(ShotsSent);
+    FMemory::Memzero(ShotsConfirmed);
+    FMemory::Memzero(ShotsRejected);
+    FMemory::Memzero(PositionChecks);
+    FMemory::Memzero(PositionCorrections);
+    FMemory::Memzero(BeamBatches);
+    CurrentSecond = -1;
+    LastRewindMs = 0.f;
+    LastNumPositionChecks = -1;
+    LastNumPositionCorrections = -1;
+}
+
+int32 FNetcodePlusNetDiagCounters::Advance(float Now)
+{
+    const int32 Second = FMath::FloorToInt(Now);
+    if (CurrentSecond < 0 || Second - CurrentSecond >= NumBuckets)
+    {
+        FMemory::Memzero(ShotsSent);
+        FMemory::Memzero(ShotsConfirmed);
+        FMemory::Memzero(ShotsRejected);
+        FMemory::Memzero(PositionChecks);
+        FMemory::Memzero(PositionCorrections);
+        FMemory::Memzero(BeamBatches);
+    }
+    else
+    {
+        for (int32 S = CurrentSecond + 1; S <= Second; S++)
+        {
+            const int32 Index = S % NumBuckets;
+            ShotsSent[Index] = ShotsConfirmed[Index] = ShotsRejected[Index] = 0;
+            PositionChecks[Index] = PositionCorrections[Index] = BeamBatches[Index] = 0;
+        }
+    }
+    CurrentSecond = FMath::Max(CurrentSecond, Second);
+    return CurrentSecond % NumBuckets;
+}
+
+uint16 FNetcodePlusNetDiagCounters::Sum(const uint16* Buckets)
+{
+    uint32 Total = 0;
+    for (int32 i = 0; i < NumBuckets; i++)
+    {
+        Total += Buckets[i];
+    }
+    return (uint16)FMath::Min<uint32>(Total, MAX_uint16);
+}
+
+void FNetcodePlusNetDiagCounters::Fill(FNetcodePlusNetDiagSnapshot& Out) const
+{
+    Out.RewindMs = (uint16)FMath::Clamp(FMath::RoundToInt(LastRewindMs), 0, (int32)MAX_uint16);
+    Out.ShotsConfirmed = Sum(ShotsConfirmed);
+    Out.ShotsRejected = Sum(ShotsRejected);
+    Out.PositionChecks = Sum(PositionChecks);
+    Out.PositionCorrections = Sum(PositionCorrections);
+    Out.BeamBatches = Sum(BeamBatches);
+}
+
+bool FNetcodePlusNetDiagnostics::IsOverlayRequested()
+{
+    return CVarNetDiag.GetValueOnGameThread() != 0;
+}
+
+/** Subscribed controller of Shooter, or null */
+static ATeamArenaPredictionPC* GetSubscribedController(APawn* Shooter)
+{
+    ATeamArenaPredictionPC* PC = Shooter ? Cast<ATeamArenaPredictionPC>(Shooter->GetController()) : nullptr;
+    return (PC && PC->IsNetDiagnosticsSubscribed()) ? PC : nullptr;
+}
+
+void FNetcodePlusNetDiagnostics::RecordShot(APawn* Shooter, bool bAccepted, float RewindSeconds)
+{
+    ATeamArenaPredictionPC* PC = GetSubscribedController(Shooter);
+    if (PC)
+    {
+        FNetcodePlusNetDiagCounters& Counters = PC->NetDiagCounters;
+        const int32 Bucket = Counters.Advance(PC->GetWorld()->GetTimeSeconds());
+        uint16& Count = bAccepted ? Counters.ShotsConfirmed[Bucket] : Counters.ShotsRejected[Bucket];
+        Count = (uint16)FMath::Min<int32>(Count + 1, MAX_uint16);
+        if (bAccepted)
+        {
+            Counters.LastRewindMs = RewindSeconds * 1000.f;
+        }
+    }
+}
+
+void FNetcodePlusNetDiagnostics::RecordBeamBatch(APawn* Shooter)
+{
+    ATeamArenaPredictionPC* PC = GetSubscribedController(Shooter);
+    if (PC)
+    {
+        FNetcodePlusNetDiagCounters& Counters = PC->NetDiagCounters;
+        uint16& Count = Counters.BeamBatches[Counters.Advance(PC->GetWorld()->GetTimeSeconds())];
+        Count = (uint16)FMath::Min<int32>(Count + 1, MAX_uint16);
+    }
+}
+
+void FNetcodePlusNetDiagnostics::RecordShotSent(APawn* Shooter)
+{
+    ATeamArenaPredictionPC* PC = Shooter ? Cast<ATeamArenaPredictionPC>(Shooter->GetController()) : nullptr;
+    if (PC && PC->IsLocalController())
+    {
+        FNetcodePlusNetDiagCounters& Counters = PC->NetDiagCounters;
+        uint16& Count = Counters.ShotsSent[Counters.Advance(PC->GetWorld()->GetTimeSeconds())];
+        Count = (uint16)FMath::Min<int32>(Count + 1, MAX_uint16);
+    }
+}
+
+void FNetcodePlusNetDiagnostics::BuildOverlayLines(const FNetcodePlusNetDiagSnapshot& Snapshot, const FNetcodePlusNetDiagCounters& ClientCounters, float ClockOffsetMs, TArray<FString>& OutLines)
+{
+    const float Window = (float)WindowSeconds;
+    const float CorrectionPct = Snapshot.PositionChecks > 0 ? 100.f * Snapshot.PositionCorrections / Snapshot.PositionChecks : 0.f;
+
+    OutLines.Reset(5);
+    OutLines.Add(FString::Printf(TEXT("NetcodePlus   rewind %d ms   clock offset %+.0f ms"), Snapshot.RewindMs, ClockOffsetMs));
+    OutLines.Add(FString::Printf(TEXT("shots (%ds)   sent %d   confirmed %d   rejected %d"), WindowSeconds,
+        FNetcodePlusNetDiagCounters::Sum(ClientCounters.ShotsSent), Snapshot.ShotsConfirmed, Snapshot.ShotsRejected));
+    OutLines.Add(FString::Printf(TEXT("corrections   %.1f/s   (%.1f%% of moves)"), Snapshot.PositionCorrections / Window, CorrectionPct));
+    OutLines.Add(FString::Printf(TEXT("link batches  %.1f/s"), Snapshot.BeamBatches / Window));
+}
+
+void FNetcodePlusNetDiagnostics::DrawOverlay(UCanvas* Canvas, const TArray<FString>& Lines, float StatsAge)
+{
+    UFont* Font = GEngine->GetSmallFont();
+    if (!Canvas || !Font)
+    {
+        return;
+    }
+
+    const float LineHeight = Font->GetMaxCharHeight();
+    const float X = Canvas->ClipX * 0.01f;
+    float Y = Canvas->ClipY * 0.3f;
+
+    // Stale stats (server stopped pushing, or not subscribed yet) are drawn greyed out
+    const bool bStale = Lines.Num() == 0 || StatsAge > 3.f;
+    Canvas->SetDrawColor(bStale ? FColor(160, 160, 160) : FColor(255, 255, 160));
+    if (Lines.Num() == 0)
+    {
+        Canvas->DrawText(Font, TEXT("NetcodePlus   waiting for server stats..."), X, Y);
+        return;
+    }
+    for (const FString& Line : Lines)
+    {
+        Canvas->DrawText(Font, Line, X, Y);
+        Y += LineHeight;
+    }
+}
@@ -0,0 +1,166 @@
+// NetcodePlusRpcStats.cpp
+
+#include "NetcodePlusRpcStats.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarRpcStats(
+    TEXT("np.RpcStats.Enable"),
+    1,
+    TEXT("Count calls/bits/estimated resends per NetcodePlus RPC per connection.\n")
+    TEXT("0 = off, 1 = on (default)"),
+    ECVF_Default);
+
+static FAutoConsoleCommand CmdNetcodePlusRpcStats(
+    TEXT("np.RpcStats"),
+    TEXT("Print per-connection NetcodePlus RPC wire usage."),
+    FConsoleCommandDelegate::CreateLambda([]() { FNetcodePlusRpcStats::Dump(*GLog); }));
+
+static FAutoConsoleCommand CmdNetcodePlusRpcStatsDump(
+    TEXT("np.RpcStatsDump"),
+    TEXT("Write per-connection NetcodePlus RPC wire usage to Saved/Logs/NetcodePlus/."),
+    FConsoleCommandDelegate::CreateLambda([]() { FNetcodePlusRpcStats::DumpToFile(TEXT("Manual")); }));
+
+static FAutoConsoleCommand CmdNetcodePlusRpcStatsReset(
+    TEXT("np.RpcStatsReset"),
+    TEXT("Clear NetcodePlus RPC counters."),
+    FConsoleCommandDelegate::CreateStatic(&FNetcodePlusRpcStats::Reset));
+
+TArray<FNetcodePlusRpcStats::FConnectionRecord> FNetcodePlusRpcStats::Records;
+FDelegateHandle FNetcodePlusRpcStats::WorldCleanupHandle;
+
+FNetcodePlusRpcStats::FScope::FScope(AActor* Actor, UFunction* InFunction)
+    : Connection(nullptr)
+    , Function(InFunction)
+    , StartBits(0)
+{
+    if (CVarRpcStats.GetValueOnGameThread() != 0 && Actor != nullptr)
+    {
+        Connection = Actor->GetNetConnection();
+        if (Connection != nullptr)
+        {
+            StartBits = Connection->SendBuffer.GetNumBits();
+        }
+    }
+}
+
+FNetcodePlusRpcStats::FScope::~FScope()
+{
+    if (Connection != nullptr && Function != nullptr)
+    {
+        const int64 EndBits = Connection->SendBuffer.GetNumBits();
+        // If the send flushed the packet mid-call, only the part in the new packet is visible (lower bound)
+        FNetcodePlusRpcStats::Record(Connection, Function, (EndBits >= StartBits) ? (EndBits - StartBits) : EndBits);
+    }
+}
+
+void FNetcodePlusRpcStats::RegisterWorldDelegates()
+{
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FNetcodePlusRpcStats::OnWorldCleanup);
+}
+
+void FNetcodePlusRpcStats::UnregisterWorldDelegates()
+{
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    Records.Empty();
+}
+
+void FNetcodePlusRpcStats::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    if (World != nullptr && World->IsGameWorld() && Records.Num() > 0)
+    {
+        DumpToFile(World->GetMapName());
+        Reset();
+    }
+}
+
+FNetcodePlusRpcStats::FConnectionRecord& FNetcodePlusRpcStats::FindOrAddRecord(UNetConnection* Connection)
+{
+    for (FConnectionRecord& Rec : Records)
+    {
+        if (Rec.Connection.Get() == Connection)
+        {
+            return Rec;
+        }
+    }
+
+    FConnectionRecord& NewRec = Records[Records.AddDefaulted()];
+    NewRec.Connection = Connection;
+    if (Connection->PlayerController && Connection->PlayerController->PlayerState)
+    {
+        NewRec.Name = Connection->PlayerController->PlayerState->PlayerName;
+    }
+    else
+    {
+        NewRec.Name = Connection->LowLevelGetRemoteAddress(true);
+    }
+    return NewRec;
+}
+
+void FNetcodePlusRpcStats::Record(UNetConnection* Connection, UFunction* Function, int64 Bits)
+{
+    FRpcCounters& Counters = FindOrAddRecord(Connection).Rpcs.FindOrAdd(Function->GetFName());
+    Counters.Calls++;
+    Counters.Bits += Bits;
+
+    if (Function->FunctionFlags & FUNC_NetReliable)
+    {
+        Counters.ReliableCalls++;
+        // Each lost packet carrying a reliable bunch resends it: expected resends = p / (1 - p)
+        const float Loss = (Connection->OutPackets > 0) ? FMath::Clamp(float(Connection->OutPacketsLost) / float(Connection->OutPackets), 0.f, 0.5f) : 0.f;
+        Counters.EstimatedResends += Loss / (1.f - Loss);
+    }
+}
+
+void FNetcodePlusRpcStats::Dump(FOutputDevice& Ar)
+{
+    Ar.Logf(TEXT("NetcodePlus RPC stats (%d connections)"), Records.Num());
+    for (const FConnectionRecord& Rec : Records)
+    {
+        uint64 TotalBits = 0;
+        for (const TPair<FName, FRpcCounters>& Pair : Rec.Rpcs)
+        {
+            TotalBits += Pair.Value.Bits;
+        }
+        Ar.Logf(TEXT("  %s%s: %llu bytes"), *Rec.Name, Rec.Connection.IsValid() ? TEXT("") : TEXT(" (closed)"), TotalBits / 8);
+
+        // Biggest first, so compression candidates are at the top
+        TArray<FName> Names;
+        Rec.Rpcs.GetKeys(Names);
+        Names.Sort([&Rec](const FName& A, const FName& B) { return Rec.Rpcs[A].Bits > Rec.Rpcs[B].Bits; });
+        for (const FName& Name : Names)
+        {
+            const FRpcCounters& C = Rec.Rpcs[Name];
+            Ar.Logf(TEXT("    %-28s calls %6u  bits %9llu  avg %6.1f  reliable %6u  est.resends %7.1f"),
+                *Name.ToString(), C.Calls, C.Bits, C.Calls > 0 ? double(C.Bits) / C.Calls : 0.0, C.ReliableCalls, C.EstimatedResends);
+        }
+    }
+}
+
+void FNetcodePlusRpcStats::DumpToFile(const FString& Reason)
+{
+    const FString FilePath = FPaths::GameLogDir() / TEXT("NetcodePlus") / FString::Printf(TEXT("RpcStats-%s-%s.txt"), *Reason, *FDateTime::Now().ToString());
+    FArchive* Writer = IFileManager::Get().CreateFileWriter(*FilePath);
+    if (Writer == nullptr)
+    {
+        UE_LOG(LogNet, Warning, TEXT("NetcodePlus: could not write %s"), *FilePath);
+        return;
+    }
+
+    FStringOutputDevice Out;
+    Out.SetAutoEmitLineTerminator(true);
+    Dump(Out);
+    FTCHARToUTF8 Utf8(*Out);
+    Writer->Serialize((UTF8CHAR*)Utf8.Get(), Utf8.Length());
+    Writer->Close();
+    delete Writer;
+    UE_LOG(LogNet, Log, TEXT("NetcodePlus: RPC stats written to %s"), *FilePath);
+}
+
+void FNetcodePlusRpcStats::Reset()
+{
+    Records.Empty();
+}
@@ -0,0 +1,334 @@
+// NetcodePlusSessionRecorder.cpp
+
+#include "NetcodePlusSessionRecorder.h"
+#include "UTCharacter.h"
+#include "UTCharacterMovement.h"
+#include "UTWeaponFix.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldAndArgs CmdNetcodePlusRecordStart(
+    TEXT("np.RecordStart"),
+    TEXT("Record pawn histories, fire/beam RPCs and hitscan validation to Saved/Profiling/NetcodePlus/<Name>.npsession (server).\n")
+    TEXT("Usage: np.RecordStart [Name]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        FNetcodePlusSessionRecorder::Start(World, Args.Num() > 0 ? Args[0] : FString());
+    }));
+
+static FAutoConsoleCommand CmdNetcodePlusRecordStop(
+    TEXT("np.RecordStop"),
+    TEXT("Stop the recording started by np.RecordStart and close the file."),
+    FConsoleCommandDelegate::CreateStatic(&FNetcodePlusSessionRecorder::Stop));
+
+/** Buffered bytes before a write to disk; a busy 10v10 server produces ~1 MB/s */
+static const int32 SessionFlushBytes = 256 * 1024;
+
+FArchive* FNetcodePlusSessionRecorder::Archive = nullptr;
+TWeakObjectPtr<UWorld> FNetcodePlusSessionRecorder::RecordedWorld;
+TArray<uint8> FNetcodePlusSessionRecorder::Buffer;
+TMap<TWeakObjectPtr<AActor>, int32> FNetcodePlusSessionRecorder::PawnIds;
+int32 FNetcodePlusSessionRecorder::NextPawnId = 0;
+FDelegateHandle FNetcodePlusSessionRecorder::EndFrameHandle;
+FDelegateHandle FNetcodePlusSessionRecorder::WorldCleanupHandle;
+
+static void CopyVector(float* Dest, const FVector& V)
+{
+    Dest[0] = V.X;
+    Dest[1] = V.Y;
+    Dest[2] = V.Z;
+}
+
+void FNetcodePlusSessionRecorder::Start(UWorld* World, const FString& Name)
+{
+    Stop();
+
+    if (World == nullptr || World->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogNet, Warning, TEXT("np.RecordStart: recording needs a server world"));
+        return;
+    }
+
+    const FString FileName = Name.IsEmpty() ? FString::Printf(TEXT("Session-%s-%s"), *World->GetMapName(), *FDateTime::Now().ToString()) : Name;
+    const FString FilePath = FPaths::ProfilingDir() / TEXT("NetcodePlus") / (FileName + TEXT(".npsession"));
+    Archive = IFileManager::Get().CreateFileWriter(*FilePath);
+    if (Archive == nullptr)
+    {
+        UE_LOG(LogNet, Warning, TEXT("np.RecordStart: could not open %s"), *FilePath);
+        return;
+    }
+
+    FNPSessionFileHeader Header;
+    FMemory::Memzero(Header);
+    Header.Magic = NPSESSION_MAGIC;
+    Header.Version = NPSESSION_VERSION;
+    Header.HeaderSize = sizeof(FNPSessionFileHeader);
+    Header.StartUnixMs = (uint64)((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+    FCStringAnsi::Strncpy(Header.MapName, TCHAR_TO_ANSI(*World->GetMapName()), NPSESSION_NAME_LEN);
+    Archive->Serialize(&Header, sizeof(Header));
+
+    RecordedWorld = World;
+    Buffer.Reset(SessionFlushBytes + 1024);
+    PawnIds.Reset();
+    NextPawnId = 0;
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FNetcodePlusSessionRecorder::OnEndFrame);
+    UE_LOG(LogNet, Log, TEXT("np.RecordStart: writing %s"), *FilePath);
+}
+
+void FNetcodePlusSessionRecorder::Stop()
+{
+    if (EndFrameHandle.IsValid())
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+        EndFrameHandle.Reset();
+    }
+    if (Archive != nullptr)
+    {
+        Flush();
+        Archive->Close();
+        delete Archive;
+        Archive = nullptr;
+        UE_LOG(LogNet, Log, TEXT("np.RecordStop: %d pawns recorded"), NextPawnId);
+    }
+    RecordedWorld.Reset();
+    Buffer.Empty();
+    PawnIds.Empty();
+}
+
+template <typename T>
+void FNetcodePlusSessionRecorder::Write(ENPSessionRecordType Type, const T& Payload)
+{
+    static_assert(sizeof(T) % 4 == 0, "Session payloads must keep records 4-byte aligned");
+
+    FNPSessionRecordHeader Header;
+    Header.Type = (uint16)Type;
+    Header.Size = (uint16)sizeof(T);
+
+    const int32 Offset = Buffer.AddUninitialized(sizeof(Header) + sizeof(T));
+    FMemory::Memcpy(Buffer.GetData() + Offset, &Header, sizeof(Header));
+    FMemory::Memcpy(Buffer.GetData() + Offset + sizeof(Header), &Payload, sizeof(T));
+}
+
+void FNetcodePlusSessionRecorder::Flush()
+{
+    if (Archive != nullptr && Buffer.Num() > 0)
+    {
+        Archive->Serialize(Buffer.GetData(), Buffer.Num());
+        Buffer.Reset();
+    }
+}
+
+bool FNetcodePlusSessionRecorder::IsRecordedWorld(const AActor* Actor)
+{
+    return Actor != nullptr && Actor->GetWorld() == RecordedWorld.Get();
+}
+
+int32 FNetcodePlusSessionRecorder::GetPawnId(AActor* Actor)
+{
+    AUTCharacter* Pawn = Cast<AUTCharacter>(Actor);
+    if (Pawn == nullptr)
+    {
+        return NPSESSION_NO_PAWN;
+    }
+
+    const int32* Existing = PawnIds.Find(Pawn);
+    if (Existing != nullptr)
+    {
+        return *Existing;
+    }
+
+    FNPSessionPawnAdd Add;
+    FMemory::Memzero(Add);
+    Add.PawnId = NextPawnId++;
+    Add.PlayerId = Pawn->PlayerState ? Pawn->PlayerState->PlayerId : -1;
+    Add.MaxSavedPositionAge = Pawn->MaxSavedPositionAge;
+    Add.TeamNum = Pawn->GetTeamNum();
+    Write(NPSessionRecord_PawnAdd, Add);
+    PawnIds.Add(Pawn, Add.PawnId);
+
+    // Pawns alive when recording started already have history the first rewinds will reach into.
+    // This frame's sample (if any) is left to the PawnMove being recorded now.
+    const float Now = Pawn->GetWorld()->GetTimeSeconds();
+    for (const FSavedPosition& Saved : Pawn->SavedPositions)
+    {
+        if (Saved.Time >= Now)
+        {
+            break;
+        }
+        FNPSessionPawnMove Seed;
+        FMemory::Memzero(Seed);
+        Seed.PawnId = Add.PawnId;
+        Seed.Time = Saved.Time;
+        CopyVector(Seed.Location, Saved.Position);
+        CopyVector(Seed.Velocity, Saved.Velocity);
+        Seed.Radius = Pawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
+        Seed.HalfHeight = Pawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+        Seed.SlideTargetHeight = Pawn->SlideTargetHeight;
+        Seed.Flags = NPSessionPawn_SampleSaved | NPSessionPawn_HistorySeed | (Saved.bTeleported ? NPSessionPawn_Teleported : 0);
+        Write(NPSessionRecord_PawnMove, Seed);
+    }
+    return Add.PawnId;
+}
+
+void FNetcodePlusSessionRecorder::RecordPawnMove(AUTCharacter* Pawn, bool bSampleSaved, bool bTeleported, bool bShotSpawned)
+{
+    if (!IsRecordedWorld(Pawn))
+    {
+        return;
+    }
+
+    FNPSessionPawnMove Move;
+    Move.PawnId = GetPawnId(Pawn);
+    Move.Time = Pawn->GetWorld()->GetTimeSeconds();
+    CopyVector(Move.Location, Pawn->GetActorLocation());
+    CopyVector(Move.Velocity, Pawn->GetVelocity());
+    Move.Radius = Pawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
+    Move.HalfHeight = Pawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+    Move.SlideTargetHeight = Pawn->SlideTargetHeight;
+    Move.Flags = 0;
+    if (Pawn->UTCharacterMovement && Pawn->UTCharacterMovement->bIsFloorSliding)
+    {
+        Move.Flags |= NPSessionPawn_Sliding;
+    }
+    if (bSampleSaved)
+    {
+        Move.Flags |= NPSessionPawn_SampleSaved;
+    }
+    if (bTeleported)
+    {
+        Move.Flags |= NPSessionPawn_Teleported;
+    }
+    if (bShotSpawned)
+    {
+        Move.Flags |= NPSessionPawn_ShotSpawned;
+    }
+    if (Pawn->IsDead())
+    {
+        Move.Flags |= NPSessionPawn_Dead;
+    }
+    Write(NPSessionRecord_PawnMove, Move);
+}
+
+void FNetcodePlusSessionRecorder::RecordPawnRemoved(AUTCharacter* Pawn)
+{
+    if (!IsRecordedWorld(Pawn))
+    {
+        return;
+    }
+
+    const int32* Existing = PawnIds.Find(Pawn);
+    if (Existing != nullptr)
+    {
+        FNPSessionPawnRemove Remove;
+        Remove.PawnId = *Existing;
+        Remove.Time = Pawn->GetWorld()->GetTimeSeconds();
+        Write(NPSessionRecord_PawnRemove, Remove);
+        PawnIds.Remove(Pawn);
+    }
+}
+
+void FNetcodePlusSessionRecorder::RecordFireRpc(AUTWeaponFix* Weapon, uint8 FireMode, int32 EventIndex, float ClientTimestamp, bool bClientPredicted, const FRotator& ViewRot, AUTCharacter* ClaimedChar, uint8 ZOffset, bool bAccepted)
+{
+    if (!IsRecordedWorld(Weapon))
+    {
+        return;
+    }
+
+    FNPSessionFireRpc Rpc;
+    FMemory::Memzero(Rpc);
+    Rpc.ReceiveTime = Weapon->GetWorld()->GetTimeSeconds();
+    Rpc.ShooterPawnId = GetPawnId(Weapon->GetUTOwner());
+    Rpc.EventIndex = EventIndex;
+    Rpc.ClientTimestamp = ClientTimestamp;
+    Rpc.ViewPitch = ViewRot.Pitch;
+    Rpc.ViewYaw = ViewRot.Yaw;
+    Rpc.ViewRoll = ViewRot.Roll;
+    Rpc.ClaimedPawnId = GetPawnId(ClaimedChar);
+    Rpc.FireMode = FireMode;
+    Rpc.bClientPredicted = bClientPredicted ? 1 : 0;
+    Rpc.ZOffset = ZOffset;
+    Rpc.bAccepted = bAccepted ? 1 : 0;
+    Write(NPSessionRecord_FireRpc, Rpc);
+}
+
+void FNetcodePlusSessionRecorder::RecordBeamRpc(AActor* Weapon, AActor* HitActor, const FVector& HitLocation, int32 Damage, uint8 SessionId, uint16 Sequence, uint8 Kind)
+{
+    AUTWeapon* UTWeapon = Cast<AUTWeapon>(Weapon);
+    if (UTWeapon == nullptr || !IsRecordedWorld(UTWeapon))
+    {
+        return;
+    }
+
+    FNPSessionBeamRpc Rpc;
+    Rpc.ReceiveTime = Weapon->GetWorld()->GetTimeSeconds();
+    Rpc.ShooterPawnId = GetPawnId(UTWeapon->GetUTOwner());
+    Rpc.TargetPawnId = GetPawnId(HitActor);
+    CopyVector(Rpc.HitLocation, HitLocation);
+    Rpc.Damage = Damage;
+    Rpc.Sequence = Sequence;
+    Rpc.SessionId = SessionId;
+    Rpc.Kind = Kind;
+    Write(NPSessionRecord_BeamRpc, Rpc);
+}
+
+void FNetcodePlusSessionRecorder::RecordHitScan(AUTWeaponFix* Weapon, AUTCharacter* ClaimedChar, AUTCharacter* ResultChar, const FVector& Start, const FVector& PawnTraceEnd,
+    float TraceRadius, float PredictionTime, float PaddingMoving, float PaddingStationary, uint8 SkipTeam)
+{
+    if (!IsRecordedWorld(Weapon))
+    {
+        return;
+    }
+
+    FNPSessionHitScan Scan;
+    FMemory::Memzero(Scan);
+    Scan.Time = Weapon->GetWorld()->GetTimeSeconds();
+    Scan.ShooterPawnId = GetPawnId(Weapon->GetUTOwner());
+    Scan.ClaimedPawnId = GetPawnId(ClaimedChar);
+    Scan.ResultPawnId = GetPawnId(ResultChar);
+    CopyVector(Scan.Start, Start);
+    CopyVector(Scan.PawnTraceEnd, PawnTraceEnd);
+    Scan.TraceRadius = TraceRadius;
+    Scan.PredictionTime = PredictionTime;
+    Scan.PaddingMoving = PaddingMoving;
+    Scan.PaddingStationary = PaddingStationary;
+    Scan.SkipTeam = SkipTeam;
+    Write(NPSessionRecord_HitScan, Scan);
+}
+
+void FNetcodePlusSessionRecorder::OnEndFrame()
+{
+    UWorld* World = RecordedWorld.Get();
+    if (World == nullptr || Archive == nullptr)
+    {
+        return;
+    }
+
+    FNPSessionTick Tick;
+    Tick.WorldTime = World->GetTimeSeconds();
+    Tick.DeltaTime = World->GetDeltaSeconds();
+    Write(NPSessionRecord_Tick, Tick);
+
+    if (Buffer.Num() >= SessionFlushBytes)
+    {
+        Flush();
+    }
+}
+
+void FNetcodePlusSessionRecorder::RegisterWorldDelegates()
+{
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FNetcodePlusSessionRecorder::OnWorldCleanup);
+}
+
+void FNetcodePlusSessionRecorder::UnregisterWorldDelegates()
+{
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    Stop();
+}
+
+void FNetcodePlusSessionRecorder::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    if (World != nullptr && World == RecordedWorld.Get())
+    {
+        Stop();
+    }
+}
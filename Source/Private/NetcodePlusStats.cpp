@@ -0,0 +1,135 @@
+// NetcodePlusStats.cpp
+
+#include "NetcodePlusStats.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/CoreDelegates.h"
+
+DEFINE_STAT(STAT_NetcodePlus_HitScanTrace);
+DEFINE_STAT(STAT_NetcodePlus_FireCone);
+DEFINE_STAT(STAT_NetcodePlus_GetRewindLocation);
+DEFINE_STAT(STAT_NetcodePlus_ServerStartFire);
+DEFINE_STAT(STAT_NetcodePlus_ServerBeamHit);
+DEFINE_STAT(STAT_NetcodePlus_PositionUpdated);
+DEFINE_STAT(STAT_NetcodePlus_SavedPositions);
+DEFINE_STAT(STAT_NetcodePlus_HeadOffsetHistory);
+DEFINE_STAT(STAT_NetcodePlus_ShockBallHistory);
+
+bool FNetcodePlusProfiler::bCapturing = false;
+uint64 FNetcodePlusProfiler::PathCycles[ENetcodePlusPath::MAX] = {};
+uint32 FNetcodePlusProfiler::PathCalls[ENetcodePlusPath::MAX] = {};
+int32 FNetcodePlusProfiler::GaugeValues[ENetcodePlusGauge::MAX] = {};
+FArchive* FNetcodePlusProfiler::CsvWriter = nullptr;
+FDelegateHandle FNetcodePlusProfiler::EndFrameHandle;
+double FNetcodePlusProfiler::LastFrameTime = 0.0;
+
+static const TCHAR* NetcodePlusPathNames[ENetcodePlusPath::MAX] =
+{
+    TEXT("HitScanTrace"),
+    TEXT("FireCone"),
+    TEXT("GetRewindLocation"),
+    TEXT("ServerStartFire"),
+    TEXT("ServerBeamHit"),
+    TEXT("PositionUpdated"),
+};
+
+static const TCHAR* NetcodePlusGaugeNames[ENetcodePlusGauge::MAX] =
+{
+    TEXT("SavedPositions"),
+    TEXT("HeadOffsetHistory"),
+    TEXT("ShockBallHistory"),
+};
+
+static FAutoConsoleCommand CmdNetcodePlusCsvStart(
+    TEXT("np.CsvStart"),
+    TEXT("Stream per-frame NetcodePlus hot path timings and history sizes to Saved/Profiling/NetcodePlus/<Name>.csv.\n")
+    TEXT("Usage: np.CsvStart [Name]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FNetcodePlusProfiler::StartCsv(Args.Num() > 0 ? Args[0] : FString());
+    }));
+
+static FAutoConsoleCommand CmdNetcodePlusCsvStop(
+    TEXT("np.CsvStop"),
+    TEXT("Stop the capture started by np.CsvStart and close the file."),
+    FConsoleCommandDelegate::CreateStatic(&FNetcodePlusProfiler::StopCsv));
+
+void FNetcodePlusProfiler::StartCsv(const FString& Name)
+{
+    StopCsv();
+
+    const FString FileName = Name.IsEmpty() ? FString::Printf(TEXT("NetcodePlus-%s"), *FDateTime::Now().ToString()) : Name;
+    const FString FilePath = FPaths::ProfilingDir() / TEXT("NetcodePlus") / (FileName + TEXT(".csv"));
+    CsvWriter = IFileManager::Get().CreateFileWriter(*FilePath);
+    if (CsvWriter == nullptr)
+    {
+        UE_LOG(LogLoad, Warning, TEXT("np.CsvStart: could not open %s"), *FilePath);
+        return;
+    }
+
+    FString Header = TEXT("Frame,FrameMs");
+    for (int32 i = 0; i < ENetcodePlusPath::MAX; i++)
+    {
+        Header += FString::Printf(TEXT(",%sMs,%sCalls"), NetcodePlusPathNames[i], NetcodePlusPathNames[i]);
+    }
+    for (int32 i = 0; i < ENetcodePlusGauge::MAX; i++)
+    {
+        Header += FString::Printf(TEXT(",%s"), NetcodePlusGaugeNames[i]);
+    }
+    WriteLine(Header);
+
+    FMemory::Memzero(PathCycles);
+    FMemory::Memzero(PathCalls);
+    LastFrameTime = FPlatformTime::Seconds();
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FNetcodePlusProfiler::OnEndFrame);
+    bCapturing = true;
+    UE_LOG(LogLoad, Log, TEXT("np.CsvStart: writing %s"), *FilePath);
+}
+
+void FNetcodePlusProfiler::StopCsv()
+{
+    bCapturing = false;
+    if (EndFrameHandle.IsValid())
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+        EndFrameHandle.Reset();
+    }
+    if (CsvWriter != nullptr)
+    {
+        CsvWriter->Close();
+        delete CsvWriter;
+        CsvWriter = nullptr;
+        UE_LOG(LogLoad, Log, TEXT("np.CsvStop: capture closed"));
+    }
+}
+
+void FNetcodePlusProfiler::OnEndFrame()
+{
+    if (CsvWriter == nullptr)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    FString Line = FString::Printf(TEXT("%llu,%.3f"), (uint64)GFrameCounter, (Now - LastFrameTime) * 1000.0);
+    LastFrameTime = Now;
+
+    for (int32 i = 0; i < ENetcodePlusPath::MAX; i++)
+    {
+        Line += FString::Printf(TEXT(",%.4f,%u"), FPlatformTime::ToMilliseconds64(PathCycles[i]), PathCalls[i]);
+    }
+    for (int32 i = 0; i < ENetcodePlusGauge::MAX; i++)
+    {
+        Line += FString::Printf(TEXT(",%d"), GaugeValues[i]);
+    }
+    WriteLine(Line);
+
+    FMemory::Memzero(PathCycles);
+    FMemory::Memzero(PathCalls);
+}
+
+void FNetcodePlusProfiler::WriteLine(const FString& Line)
+{
+    FTCHARToUTF8 Utf8(*(Line + LINE_TERMINATOR));
+    CsvWriter->Serialize((UTF8CHAR*)Utf8.Get(), Utf8.Length());
+}
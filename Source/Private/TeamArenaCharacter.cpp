@@ -3,7 +3,26 @@
 #include "UTCharacterMovement.h"
 #include "UTWeaponAttachment.h"
 #include "UTWeaponFix.h"
+#include "TeamArenaCollisionRoster.h"
+#include "NetcodePlusStats.h"
+#include "NetcodePlusSessionRecorder.h"
+#include "NetcodePlusLagCompKernel.h"
+#include "NetcodePlusNetRateKernel.h"
 #include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sim Proxy Encroach Queries"), STAT_NetcodePlus_EncroachQueries, STATGROUP_NetcodePlus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sim Proxy Encroach Skipped"), STAT_NetcodePlus_EncroachSkipped, STATGROUP_NetcodePlus);
+
+const float FSavedHeadOffset::Scale = 32.0f;
+
+static TAutoConsoleVariable<int32> CVarProxyInterpolation(
+    TEXT("np.ProxyInterpolation"),
+    0,
+    TEXT("Render simulated proxies from a buffer of timestamped server snapshots.\n")
+    TEXT("0 = snap to each update and use SmoothCorrection (default)\n")
+    TEXT("1 = snapshot interpolation with a jitter-adaptive delay"),
+    ECVF_Default);
 
 
 ATeamArenaCharacter::ATeamArenaCharacter(const FObjectInitializer& ObjectInitializer)
@@ -17,9 +36,146 @@ ATeamArenaCharacter::ATeamArenaCharacter(const FObjectInitializer& ObjectInitial
     PositionSaveRate = 120.0f;
     PositionSaveInterval = 1.0f / PositionSaveRate;
     LastPositionSaveTime = 0.0f;
+    ReportedSavedPositions = 0;
+    ReportedHeadOffsets = 0;
+    HeadPoseRefreshInterval = 0.05f;
+    LastHeadPoseRefreshTime = -1000.0f;
+    EncroachCheckSkipDistance = 8.0f;
+    EncroachCheckFullDistance = 64.0f;
+    LastVerifiedFreeLocation = FVector::ZeroVector;
+    bHasVerifiedFreeLocation = false;
+
+    SnapshotServerTime = 0.0f;
+    LastStampedLocation = FVector::ZeroVector;
+    LastStampedRotation = FRotator::ZeroRotator;
+    LastStampedVelocity = FVector::ZeroVector;
+    SnapshotHead = 0;
+    SnapshotCount = 0;
+    SnapshotClockOffset = 0.0f;
+    SnapshotArrivalJitter = 0.0f;
+    SnapshotInterval = 0.01f;
+    MinSnapshotInterpDelay = 0.02f;
+    MaxSnapshotInterpDelay = 0.1f;
+    SnapshotJitterScale = 2.0f;
+    SnapshotTeleportDistance = 256.0f;
+    SnapshotInterpDelay = MinSnapshotInterpDelay;
+
+    bAdaptiveNetUpdateFrequency = true;
+    MaxAdaptiveNetUpdateFrequency = 100.0f;
+    MinAdaptiveNetUpdateFrequency = 20.0f;
+    AdaptiveNearDistance = 2000.0f;
+    AdaptiveFarDistance = 8000.0f;
+    AdaptiveViewConeDot = 0.5f;
+    EngagementHoldTime = 1.0f;
+    AdaptiveRateUpdateInterval = 0.25f;
+    AdaptiveLOSRecheckTime = 0.5f;
+    MaxAdaptiveLOSTracesPerUpdate = 4;
+}
+
+void ATeamArenaCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME_CONDITION(ATeamArenaCharacter, SnapshotServerTime, COND_SimulatedOnly);
+}
+
+void ATeamArenaCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+    // Stamp before Super gathers the replicated movement so both describe the same instant.
+    // Only restamp when the replicated movement changed (turning in place counts, or proxies in
+    // interpolation mode would drop the update as a duplicate), so idle pawns don't send a new
+    // float every update.
+    const FRotator Rotation = GetActorRotation();
+    const FVector Velocity = GetVelocity();
+    if (GetActorLocation() != LastStampedLocation || Rotation != LastStampedRotation || Velocity != LastStampedVelocity)
+    {
+        LastStampedLocation = GetActorLocation();
+        LastStampedRotation = Rotation;
+        LastStampedVelocity = Velocity;
+        SnapshotServerTime = GetWorld()->GetTimeSeconds();
+    }
+
+    Super::PreReplication(ChangedPropertyTracker);
+}
+
+
+
+
+// --- TEAM COLLISION ROSTER ---
+// Anything that changes whether teammates should pass through us pushes an update here,
+// so UTeamArenaCharacterMovement never has to poll the pawn list.
+
+void ATeamArenaCharacter::BeginPlay()
+{
+    Super::BeginPlay();
+    FTeamArenaCollisionRoster::Get(GetWorld()).NotifyCharacterChanged(this);
+
+    if (Role == ROLE_Authority && bAdaptiveNetUpdateFrequency && GetNetMode() != NM_Standalone)
+    {
+        GetWorldTimerManager().SetTimer(AdaptiveNetRateHandle, this, &ATeamArenaCharacter::UpdateAdaptiveNetRates, AdaptiveRateUpdateInterval, true);
+    }
+}
+
+void ATeamArenaCharacter::Destroyed()
+{
+    // Find, not Get: during world teardown the roster may already be gone and must not be recreated
+    if (FTeamArenaCollisionRoster* Roster = FTeamArenaCollisionRoster::Find(GetWorld()))
+    {
+        Roster->RemoveCharacter(this);
+    }
+    GetWorldTimerManager().ClearTimer(AdaptiveNetRateHandle);
+    Super::Destroyed();
+}
+
+void ATeamArenaCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Take our history out of the global stat gauges
+    NETCODEPLUS_GAUGE_UPDATE(STAT_NetcodePlus_SavedPositions, SavedPositions, ReportedSavedPositions, 0);
+    NETCODEPLUS_GAUGE_UPDATE(STAT_NetcodePlus_HeadOffsetHistory, HeadOffsetHistory, ReportedHeadOffsets, 0);
+    ReportedSavedPositions = 0;
+    ReportedHeadOffsets = 0;
+    if (FNetcodePlusSessionRecorder::IsRecording())
+    {
+        FNetcodePlusSessionRecorder::RecordPawnRemoved(this);
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
+void ATeamArenaCharacter::PossessedBy(AController* NewController)
+{
+    Super::PossessedBy(NewController);
+    FTeamArenaCollisionRoster::Get(GetWorld()).NotifyCharacterChanged(this);
 }
 
+void ATeamArenaCharacter::OnRep_PlayerState()
+{
+    Super::OnRep_PlayerState();
+    FTeamArenaCollisionRoster::Get(GetWorld()).NotifyCharacterChanged(this);
+}
 
+void ATeamArenaCharacter::NotifyTeamChanged()
+{
+    Super::NotifyTeamChanged();
+    FTeamArenaCollisionRoster::Get(GetWorld()).NotifyCharacterChanged(this);
+}
+
+void ATeamArenaCharacter::PlayDying()
+{
+    Super::PlayDying();
+    FTeamArenaCollisionRoster::Get(GetWorld()).NotifyCharacterChanged(this);
+}
+
+void ATeamArenaCharacter::StartRagdoll()
+{
+    Super::StartRagdoll();
+    FTeamArenaCollisionRoster::Get(GetWorld()).NotifyCharacterChanged(this);
+}
+
+void ATeamArenaCharacter::StopRagdoll()
+{
+    Super::StopRagdoll();
+    FTeamArenaCollisionRoster::Get(GetWorld()).NotifyCharacterChanged(this);
+}
 
 
 float ATeamArenaCharacter::GetClientVisualPredictionTime() const
@@ -30,6 +186,8 @@ float ATeamArenaCharacter::GetClientVisualPredictionTime() const
 
 void ATeamArenaCharacter::PositionUpdated(bool bShotSpawned)
 {
+    NETCODEPLUS_SCOPE(STAT_NetcodePlus_PositionUpdated, PositionUpdated);
+
     // --- HIGH-FPS FIX: Throttle SavedPositions to 120Hz ---
     // This reduces array size and RemoveAt(0) frequency by 4x at 480 FPS
 
@@ -41,6 +199,11 @@ void ATeamArenaCharacter::PositionUpdated(bool bShotSpawned)
     {
         if ((WorldTime - LastPositionSaveTime) < PositionSaveInterval)
         {
+            // Still a move as far as hit validation is concerned (current location / slide state)
+            if (FNetcodePlusSessionRecorder::IsRecording() && Role == ROLE_Authority)
+            {
+                FNetcodePlusSessionRecorder::RecordPawnMove(this, false, false, false);
+            }
             return;  // Skip this frame, not enough time elapsed
         }
     }
@@ -62,10 +225,111 @@ void ATeamArenaCharacter::PositionUpdated(bool bShotSpawned)
     }
 
     // Maintain one position beyond MaxSavedPositionAge for interpolation
-    if (SavedPositions.Num() > 1 && SavedPositions[1].Time < WorldTime - MaxSavedPositionAge)
+    if (NetcodePlusLagComp::ShouldTrimOldestSample(SavedPositions.Num(), SavedPositions.Num() > 1 ? SavedPositions[1].Time : 0.f, WorldTime, MaxSavedPositionAge))
     {
         SavedPositions.RemoveAt(0);
     }
+
+    if (FNetcodePlusSessionRecorder::IsRecording() && Role == ROLE_Authority)
+    {
+        FNetcodePlusSessionRecorder::RecordPawnMove(this, GetCharacterMovement() != nullptr,
+            GetCharacterMovement() && GetCharacterMovement()->bJustTeleported, bShotSpawned);
+    }
+
+    // --- HEADSHOT REWIND: head pose history, same cadence as SavedPositions ---
+    if (Role == ROLE_Authority)
+    {
+        SaveHeadOffset(WorldTime);
+    }
+
+    NETCODEPLUS_GAUGE_UPDATE(STAT_NetcodePlus_SavedPositions, SavedPositions, ReportedSavedPositions, SavedPositions.Num());
+    NETCODEPLUS_GAUGE_UPDATE(STAT_NetcodePlus_HeadOffsetHistory, HeadOffsetHistory, ReportedHeadOffsets, HeadOffsetHistory.Num());
+    ReportedSavedPositions = SavedPositions.Num();
+    ReportedHeadOffsets = HeadOffsetHistory.Num();
+}
+
+void ATeamArenaCharacter::SaveHeadOffset(float WorldTime)
+{
+    USkeletalMeshComponent* CharMesh = GetMesh();
+    if (CharMesh == nullptr || !CharMesh->IsRegistered())
+    {
+        return;
+    }
+
+    bool bPoseCurrent = CharMesh->ShouldTickPose();
+    if (!bPoseCurrent && (HeadOffsetHistory.Num() == 0 || WorldTime - LastHeadPoseRefreshTime >= HeadPoseRefreshInterval))
+    {
+        // Dedicated server: nobody renders us, so the pose only moves when someone asks.
+        // Same forced update AUTCharacter::GetHeadLocation does, at a fraction of the save rate.
+        CharMesh->TickAnimation(0.0f, false);
+        CharMesh->RefreshBoneTransforms();
+        CharMesh->UpdateComponentToWorld();
+        LastHeadPoseRefreshTime = WorldTime;
+        bPoseCurrent = true;
+    }
+
+    const FRotator BodyRotation(0.0f, GetActorRotation().Yaw, 0.0f);
+    FVector LocalOffset;
+    if (bPoseCurrent)
+    {
+        // Same point AUTCharacter::GetHeadLocation uses, in the body's frame
+        const FVector Offset = CharMesh->GetSocketLocation(HeadBone) + GetActorRotation().RotateVector(HeadOffset) - GetActorLocation();
+        LocalOffset = BodyRotation.UnrotateVector(Offset);
+    }
+    else
+    {
+        LocalOffset = HeadOffsetHistory.Last().GetLocal();
+    }
+
+    HeadOffsetHistory.AddUninitialized();
+    HeadOffsetHistory.Last().Set(WorldTime, LocalOffset, BodyRotation.Yaw);
+
+    if (HeadOffsetHistory.Num() > 1 && HeadOffsetHistory[1].Time < WorldTime - MaxSavedPositionAge)
+    {
+        HeadOffsetHistory.RemoveAt(0);
+    }
+}
+
+bool ATeamArenaCharacter::GetRewoundHeadOffset(float TargetTime, FVector& OutOffset) const
+{
+    const int32 Num = HeadOffsetHistory.Num();
+    if (Num == 0 || HeadOffsetHistory[0].Time > TargetTime)
+    {
+        return false;
+    }
+
+    for (int32 i = Num - 1; i >= 0; i--)
+    {
+        if (HeadOffsetHistory[i].Time <= TargetTime)
+        {
+            const FSavedHeadOffset& Before = HeadOffsetHistory[i];
+            FVector LocalOffset = Before.GetLocal();
+            float Yaw = Before.GetYaw();
+            if (i < Num - 1 && HeadOffsetHistory[i + 1].Time != Before.Time)
+            {
+                const FSavedHeadOffset& After = HeadOffsetHistory[i + 1];
+                const float Percent = (TargetTime - Before.Time) / (After.Time - Before.Time);
+                LocalOffset = FMath::Lerp(LocalOffset, After.GetLocal(), Percent);
+                Yaw += FRotator::NormalizeAxis(After.GetYaw() - Yaw) * Percent;
+            }
+            OutOffset = FRotator(0.0f, Yaw, 0.0f).RotateVector(LocalOffset);
+            return true;
+        }
+    }
+    return false;
+}
+
+FVector ATeamArenaCharacter::GetHeadLocation(float PredictionTime)
+{
+    if (PredictionTime > 0.f && Role == ROLE_Authority && GetNetMode() != NM_Client)
+    {
+        FVector RewoundOffset;
+        if (GetRewoundHeadOffset(GetWorld()->GetTimeSeconds() - PredictionTime, RewoundOffset))
+        {
+            return GetRewindLocation(PredictionTime) + RewoundOffset;
+        }
+    }
+    return Super::GetHeadLocation(PredictionTime);
 }
 
 
@@ -76,19 +340,22 @@ void ATeamArenaCharacter::UTUpdateSimulatedPosition(const FVector& NewLocation,
     {
         UTCharacterMovement->SimulatedVelocity = NewVelocity;
 
+        // Snapshot interpolation: just buffer it, the movement component moves us at the render time.
+        // Spawn always goes through the normal path so the capsule starts at the right spot.
+        if (UsesSnapshotInterpolation() && CreationTime != GetWorld()->TimeSeconds)
+        {
+            AddSnapshot(NewLocation, NewRotation, NewVelocity);
+            return;
+        }
+        SnapshotCount = 0;
+
         // 2. Update Location (The "Correction" Logic)
         // If the location has changed, or we just spawned...
         if ((NewLocation != GetActorLocation()) || (CreationTime == GetWorld()->TimeSeconds))
         {
             // Standard check to disable gravity if we are stuck in geometry
-            if (GetWorld()->EncroachingBlockingGeometry(this, NewLocation, NewRotation))
-            {
-                bSimGravityDisabled = true;
-            }
-            else
-            {
-                bSimGravityDisabled = false;
-            }
+            // (cached - see IsSimulatedLocationEncroaching)
+            bSimGravityDisabled = IsSimulatedLocationEncroaching(NewLocation, NewRotation);
 
             // --- FORCE PREDICT 0 LOGIC STARTS HERE ---
 
@@ -123,6 +390,373 @@ void ATeamArenaCharacter::UTUpdateSimulatedPosition(const FVector& NewLocation,
 }
 
 
+// --- ADAPTIVE NET UPDATE FREQUENCY ---
+// Every pawn used to replicate at 100Hz to everyone. Now each viewer gets a desired rate from
+// distance, view cone, LOS and recent hitscan exchanges. UE only has one NetUpdateFrequency per actor,
+// so we run at the max any viewer needs and IsReplicationPausedForConnection paces each connection
+// down to its own rate. GetNetPriority also scales by that rate so the far/occluded connections give
+// way first when bandwidth is tight.
+
+int32 ATeamArenaCharacter::FindOrAddViewerNetRate(APlayerController* Viewer)
+{
+    for (int32 i = 0; i < ViewerNetRates.Num(); i++)
+    {
+        if (ViewerNetRates[i].Viewer.Get() == Viewer)
+        {
+            return i;
+        }
+    }
+
+    FViewerNetRate NewEntry;
+    NewEntry.Viewer = Viewer;
+    NewEntry.DesiredRate = MaxAdaptiveNetUpdateFrequency;
+    NewEntry.LastEngagedTime = -1000.0f;
+    NewEntry.bLineOfSightBlocked = false;
+    NewEntry.LastLOSTraceTime = -1000.0f;
+    NewEntry.NextReplicationTime = 0.0f;
+    return ViewerNetRates.Add(NewEntry);
+}
+
+void ATeamArenaCharacter::UpdateAdaptiveNetRates()
+{
+    if (!bAdaptiveNetUpdateFrequency)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    const float WorldTime = World->GetTimeSeconds();
+    const FVector MyLocation = GetActorLocation();
+
+    ViewerNetRates.RemoveAllSwap([](const FViewerNetRate& Entry) { return !Entry.Viewer.IsValid(); });
+
+    // LOS traces are the only real cost here, and with 16+ viewers they'd run every update for
+    // every pawn. Results are cached per viewer and only MaxAdaptiveLOSTracesPerUpdate are refreshed
+    // per update, stalest first, so a viewer late in the controller list still gets its turn.
+    struct FRateCandidate
+    {
+        int32 EntryIndex;
+        APawn* ViewPawn;
+        FVector ViewLocation;
+        float Relevance;
+        bool bWantsLOS;
+    };
+    TArray<FRateCandidate, TInlineAllocator<32>> Candidates;
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PC = It->Get();
+        if (PC == nullptr || PC == GetController() || PC->IsLocalController())
+        {
+            continue;
+        }
+
+        const int32 EntryIndex = FindOrAddViewerNetRate(PC);
+        FViewerNetRate& Entry = ViewerNetRates[EntryIndex];
+        if (WorldTime - Entry.LastEngagedTime < EngagementHoldTime)
+        {
+            Entry.DesiredRate = MaxAdaptiveNetUpdateFrequency;
+            continue;
+        }
+
+        FVector ViewLocation;
+        FRotator ViewRotation;
+        PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+        const FVector ToUs = MyLocation - ViewLocation;
+        const float Distance = ToUs.Size();
+
+        // 1. Distance: full inside Near, fading to 0 at Far
+        float Relevance = NetcodePlusNetRate::DistanceRelevance(Distance, AdaptiveNearDistance, AdaptiveFarDistance);
+
+        // 2. View cone: behind the viewer matters much less (still some, they can turn around)
+        const bool bInView = Distance < 1.0f || ((ToUs / Distance) | ViewRotation.Vector()) >= AdaptiveViewConeDot;
+        if (!bInView)
+        {
+            Relevance *= NetcodePlusNetRate::OutOfViewScale;
+        }
+
+        FRateCandidate Candidate;
+        Candidate.EntryIndex = EntryIndex;
+        Candidate.ViewPawn = PC->GetPawn();
+        Candidate.ViewLocation = ViewLocation;
+        Candidate.Relevance = Relevance;
+        // 3. LOS: only worth a trace if it could change the answer
+        Candidate.bWantsLOS = bInView && Relevance > 0.0f;
+        Candidates.Add(Candidate);
+    }
+
+    TArray<int32, TInlineAllocator<32>> StaleLOS;
+    for (int32 i = 0; i < Candidates.Num(); i++)
+    {
+        if (Candidates[i].bWantsLOS && WorldTime - ViewerNetRates[Candidates[i].EntryIndex].LastLOSTraceTime >= AdaptiveLOSRecheckTime)
+        {
+            StaleLOS.Add(i);
+        }
+    }
+    if (StaleLOS.Num() > MaxAdaptiveLOSTracesPerUpdate)
+    {
+        StaleLOS.Sort([&](int32 A, int32 B)
+        {
+            return ViewerNetRates[Candidates[A].EntryIndex].LastLOSTraceTime < ViewerNetRates[Candidates[B].EntryIndex].LastLOSTraceTime;
+        });
+        StaleLOS.SetNum(FMath::Max(MaxAdaptiveLOSTracesPerUpdate, 0));
+    }
+    for (int32 CandidateIndex : StaleLOS)
+    {
+        const FRateCandidate& Candidate = Candidates[CandidateIndex];
+        FViewerNetRate& Entry = ViewerNetRates[Candidate.EntryIndex];
+        FCollisionQueryParams Params(FName(TEXT("AdaptiveNetRateLOS")), false, this);
+        Params.AddIgnoredActor(Candidate.ViewPawn);
+        Entry.bLineOfSightBlocked = World->LineTraceTestByChannel(Candidate.ViewLocation, MyLocation, ECC_Visibility, Params);
+        Entry.LastLOSTraceTime = WorldTime;
+    }
+
+    for (const FRateCandidate& Candidate : Candidates)
+    {
+        FViewerNetRate& Entry = ViewerNetRates[Candidate.EntryIndex];
+        float Relevance = Candidate.Relevance;
+        if (Candidate.bWantsLOS && Entry.bLineOfSightBlocked)
+        {
+            Relevance *= NetcodePlusNetRate::OccludedScale;
+        }
+        Entry.DesiredRate = NetcodePlusNetRate::DesiredRate(MinAdaptiveNetUpdateFrequency, MaxAdaptiveNetUpdateFrequency, Relevance);
+    }
+
+    ApplyNetUpdateFrequency();
+}
+
+void ATeamArenaCharacter::ApplyNetUpdateFrequency()
+{
+    float Rate = ViewerNetRates.Num() > 0 ? MinAdaptiveNetUpdateFrequency : MaxAdaptiveNetUpdateFrequency;
+    for (const FViewerNetRate& Entry : ViewerNetRates)
+    {
+        Rate = FMath::Max(Rate, Entry.DesiredRate);
+    }
+
+    NetUpdateFrequency = Rate;
+    MinNetUpdateFrequency = Rate;
+}
+
+void ATeamArenaCharacter::NotifyHitScanEngagement(APlayerController* Viewer)
+{
+    if (Role != ROLE_Authority || !bAdaptiveNetUpdateFrequency || Viewer == nullptr)
+    {
+        return;
+    }
+
+    FViewerNetRate& Entry = ViewerNetRates[FindOrAddViewerNetRate(Viewer)];
+    Entry.LastEngagedTime = GetWorld()->GetTimeSeconds();
+    Entry.NextReplicationTime = 0.0f;
+    if (Entry.DesiredRate < MaxAdaptiveNetUpdateFrequency)
+    {
+        Entry.DesiredRate = MaxAdaptiveNetUpdateFrequency;
+        ApplyNetUpdateFrequency();
+        ForceNetUpdate();
+    }
+}
+
+bool ATeamArenaCharacter::IsReplicationPausedForConnection(const FNetViewer& ConnectionOwnerNetViewer)
+{
+    if (Super::IsReplicationPausedForConnection(ConnectionOwnerNetViewer))
+    {
+        return true;
+    }
+
+    // Owner and viewers we have no rate for yet always get the update. Each flip of the paused state
+    // costs the connection a small bunch, which Tools/NetcodePlusNetRate counts in its numbers.
+    APlayerController* Viewer = Cast<APlayerController>(ConnectionOwnerNetViewer.InViewer);
+    if (!bAdaptiveNetUpdateFrequency || Viewer == nullptr || Viewer == GetController())
+    {
+        return false;
+    }
+
+    for (FViewerNetRate& Entry : ViewerNetRates)
+    {
+        if (Entry.Viewer.Get() == Viewer)
+        {
+            return !NetcodePlusNetRate::ShouldReplicate(Entry.NextReplicationTime, GetWorld()->GetTimeSeconds(), Entry.DesiredRate);
+        }
+    }
+    return false;
+}
+
+float ATeamArenaCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+    float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+    if (bAdaptiveNetUpdateFrequency && Viewer && MaxAdaptiveNetUpdateFrequency > 0.0f)
+    {
+        for (const FViewerNetRate& Entry : ViewerNetRates)
+        {
+            if (Entry.Viewer.Get() == Viewer)
+            {
+                Priority *= Entry.DesiredRate / MaxAdaptiveNetUpdateFrequency;
+                break;
+            }
+        }
+    }
+    return Priority;
+}
+
+
+// --- SNAPSHOT INTERPOLATION ---
+// Each replicated move carries SnapshotServerTime. We keep the last few in a ring and draw the proxy
+// SnapshotInterpDelay behind the newest one, so late/bunched packets don't show as stutter.
+// The delay follows the measured arrival jitter, and the PC reports it to the server for the rewind.
+
+bool ATeamArenaCharacter::UsesSnapshotInterpolation() const
+{
+    return (Role == ROLE_SimulatedProxy) && (CVarProxyInterpolation.GetValueOnGameThread() != 0);
+}
+
+void ATeamArenaCharacter::AddSnapshot(const FVector& NewLocation, const FRotator& NewRotation, const FVector& NewVelocity)
+{
+    const float LocalTime = GetWorld()->GetTimeSeconds();
+    const float Offset = LocalTime - SnapshotServerTime;
+
+    if (SnapshotCount > 0)
+    {
+        const FProxySnapshot& Newest = GetSnapshot(SnapshotCount - 1);
+        const float ServerDelta = SnapshotServerTime - Newest.ServerTime;
+
+        // Duplicate or out of order (same stamp re-sent with a rotation-only change) - ignore
+        if (ServerDelta <= 0.0f)
+        {
+            return;
+        }
+
+        // Teleport/respawn: don't interpolate through walls
+        const FVector Expected = Newest.Location + Newest.Velocity * ServerDelta;
+        if ((NewLocation - Expected).SizeSquared() > FMath::Square(SnapshotTeleportDistance))
+        {
+            SnapshotCount = 0;
+        }
+        else
+        {
+            SnapshotInterval += 0.1f * (FMath::Min(ServerDelta, MaxSnapshotInterpDelay) - SnapshotInterval);
+            SnapshotArrivalJitter += 0.1f * (FMath::Abs(Offset - SnapshotClockOffset) - SnapshotArrivalJitter);
+            SnapshotClockOffset += 0.05f * (Offset - SnapshotClockOffset);
+        }
+    }
+
+    if (SnapshotCount == 0)
+    {
+        SnapshotHead = 0;
+        SnapshotClockOffset = Offset;
+    }
+    else if (SnapshotCount == SnapshotBufferSize)
+    {
+        SnapshotHead = (SnapshotHead + 1) % SnapshotBufferSize;
+        SnapshotCount--;
+    }
+
+    FProxySnapshot& Snapshot = SnapshotBuffer[(SnapshotHead + SnapshotCount) % SnapshotBufferSize];
+    Snapshot.Location = NewLocation;
+    Snapshot.Rotation = NewRotation;
+    Snapshot.Velocity = NewVelocity;
+    Snapshot.ServerTime = SnapshotServerTime;
+    SnapshotCount++;
+}
+
+float ATeamArenaCharacter::GetSnapshotRenderServerTime() const
+{
+    return GetWorld()->GetTimeSeconds() - SnapshotClockOffset - SnapshotInterpDelay;
+}
+
+bool ATeamArenaCharacter::ApplySnapshotInterpolation(float DeltaTime)
+{
+    if (!UsesSnapshotInterpolation() || SnapshotCount == 0)
+    {
+        return false;
+    }
+
+    // Adapt the delay slowly so the render clock never visibly jumps
+    const float TargetDelay = FMath::Clamp(SnapshotInterval + SnapshotJitterScale * SnapshotArrivalJitter, MinSnapshotInterpDelay, MaxSnapshotInterpDelay);
+    SnapshotInterpDelay = FMath::FInterpTo(SnapshotInterpDelay, TargetDelay, DeltaTime, 2.0f);
+
+    const float RenderTime = GetSnapshotRenderServerTime();
+
+    FVector Location;
+    FRotator Rotation;
+    FVector NewVelocity;
+
+    const FProxySnapshot& Oldest = GetSnapshot(0);
+    const FProxySnapshot& Newest = GetSnapshot(SnapshotCount - 1);
+    if (RenderTime <= Oldest.ServerTime)
+    {
+        Location = Oldest.Location;
+        Rotation = Oldest.Rotation;
+        NewVelocity = Oldest.Velocity;
+    }
+    else if (RenderTime >= Newest.ServerTime)
+    {
+        // Buffer ran dry - extrapolate a little rather than freeze
+        const float ExtrapolateTime = FMath::Min(RenderTime - Newest.ServerTime, MinSnapshotInterpDelay);
+        Location = Newest.Location + Newest.Velocity * ExtrapolateTime;
+        Rotation = Newest.Rotation;
+        NewVelocity = Newest.Velocity;
+    }
+    else
+    {
+        int32 i = SnapshotCount - 2;
+        while (i > 0 && GetSnapshot(i).ServerTime > RenderTime)
+        {
+            i--;
+        }
+        const FProxySnapshot& Pre = GetSnapshot(i);
+        const FProxySnapshot& Post = GetSnapshot(i + 1);
+        const float Alpha = (RenderTime - Pre.ServerTime) / (Post.ServerTime - Pre.ServerTime);
+        Location = FMath::Lerp(Pre.Location, Post.Location, Alpha);
+        Rotation = FQuat::Slerp(Pre.Rotation.Quaternion(), Post.Rotation.Quaternion(), Alpha).Rotator();
+        NewVelocity = FMath::Lerp(Pre.Velocity, Post.Velocity, Alpha);
+    }
+
+    SetActorLocationAndRotation(Location, Rotation, false);
+    if (GetCharacterMovement())
+    {
+        GetCharacterMovement()->Velocity = NewVelocity;
+    }
+    return true;
+}
+
+
+bool ATeamArenaCharacter::IsSimulatedLocationEncroaching(const FVector& NewLocation, const FRotator& NewRotation)
+{
+    // --- HIGH-FPS FIX: Skip the overlap query for small replicated moves ---
+    // At 100Hz NetUpdateFrequency x 31 proxies this was ~3100 full overlap queries/sec on a client,
+    // just to decide bSimGravityDisabled.
+    const bool bJustSpawned = (CreationTime == GetWorld()->TimeSeconds);
+    const bool bLargeCorrection = (NewLocation - GetActorLocation()).SizeSquared() > FMath::Square(EncroachCheckFullDistance);
+
+    if (!bJustSpawned && !bLargeCorrection && bHasVerifiedFreeLocation)
+    {
+        // A. Still close to a spot the full query already cleared
+        if ((NewLocation - LastVerifiedFreeLocation).SizeSquared() <= FMath::Square(EncroachCheckSkipDistance))
+        {
+            INC_DWORD_STAT(STAT_NetcodePlus_EncroachSkipped);
+            return false;
+        }
+
+        // B. Walking on a floor the movement component already found - can't be stuck in geometry
+        if (UTCharacterMovement && UTCharacterMovement->MovementMode == MOVE_Walking && UTCharacterMovement->CurrentFloor.IsWalkableFloor())
+        {
+            INC_DWORD_STAT(STAT_NetcodePlus_EncroachSkipped);
+            return false;
+        }
+    }
+
+    // Teleport, respawn, big correction, or we're somewhere new in the air - do the real query
+    INC_DWORD_STAT(STAT_NetcodePlus_EncroachQueries);
+    const bool bEncroaching = GetWorld()->EncroachingBlockingGeometry(this, NewLocation, NewRotation);
+    bHasVerifiedFreeLocation = !bEncroaching;
+    if (!bEncroaching)
+    {
+        LastVerifiedFreeLocation = NewLocation;
+    }
+    return bEncroaching;
+}
+
+
 void ATeamArenaCharacter::FiringInfoUpdated()
 {
     // 1. Interrupt Animation (Standard)
@@ -337,6 +971,8 @@ void ATeamArenaCharacter::FiringInfoUpdated()
 
 FVector ATeamArenaCharacter::GetRewindLocation(float PredictionTime, AUTPlayerController* DebugViewer)
 {
+    NETCODEPLUS_SCOPE(STAT_NetcodePlus_GetRewindLocation, GetRewindLocation);
+
     float ActualPredictionTime = PredictionTime;
 
     // --- CRITICAL FIX ---
@@ -352,50 +988,23 @@ FVector ATeamArenaCharacter::GetRewindLocation(float PredictionTime, AUTPlayerCo
     // (calculated in UTWeaponFix::HitScanTrace). If we zero this out, 
     // we break hit registration.
 
-    // --- STANDARD UT LOGIC (Adapted) ---
-    FVector TargetLocation = GetActorLocation();
-    FVector PrePosition = GetActorLocation();
-    FVector PostPosition = GetActorLocation();
-
+    // --- STANDARD UT LOGIC (shared kernel, so offline replays run the same walk) ---
     // Use the calculated time based on the logic above
-    float TargetTime = GetWorld()->GetTimeSeconds() - ActualPredictionTime;
-    float Percent = 0.999f;
-    bool bTeleported = false;
+    const float TargetTime = GetWorld()->GetTimeSeconds() - ActualPredictionTime;
+    NetcodePlusLagComp::TRewindInfo<FVector> Info;
+    Info.PrePosition = Info.PostPosition = GetActorLocation();
+    Info.Percent = 0.999f;
+    Info.bTeleported = false;
 
+    FVector TargetLocation = GetActorLocation();
     if (ActualPredictionTime > 0.f)
     {
-        for (int32 i = SavedPositions.Num() - 1; i >= 0; i--)
-        {
-            TargetLocation = SavedPositions[i].Position;
-            if (SavedPositions[i].Time < TargetTime)
-            {
-                if (!SavedPositions[i].bTeleported && (i < SavedPositions.Num() - 1))
-                {
-                    PrePosition = SavedPositions[i].Position;
-                    PostPosition = SavedPositions[i + 1].Position;
-                    if (SavedPositions[i + 1].Time == SavedPositions[i].Time)
-                    {
-                        Percent = 1.f;
-                        TargetLocation = SavedPositions[i + 1].Position;
-                    }
-                    else
-                    {
-                        Percent = (TargetTime - SavedPositions[i].Time) / (SavedPositions[i + 1].Time - SavedPositions[i].Time);
-                        TargetLocation = SavedPositions[i].Position + Percent * (SavedPositions[i + 1].Position - SavedPositions[i].Position);
-                    }
-                }
-                else
-                {
-                    bTeleported = SavedPositions[i].bTeleported;
-                }
-                break;
-            }
-        }
+        TargetLocation = NetcodePlusLagComp::RewindLocation(SavedPositions.GetData(), SavedPositions.Num(), GetActorLocation(), TargetTime, &Info);
     }
 
     if (DebugViewer)
     {
-        DebugViewer->ClientDebugRewind(GetActorLocation(), TargetLocation, PrePosition, PostPosition, GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight(), ActualPredictionTime, Percent, bTeleported);
+        DebugViewer->ClientDebugRewind(GetActorLocation(), TargetLocation, Info.PrePosition, Info.PostPosition, GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight(), ActualPredictionTime, Info.Percent, Info.bTeleported);
     }
 
     return TargetLocation;
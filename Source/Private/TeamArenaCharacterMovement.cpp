@@ -3,87 +3,234 @@
 
 #include "TeamArenaCharacterMovement.h"
 #include "TeamArenaCharacter.h"
+#include "TeamArenaCollisionRoster.h"
 #include "UTGameState.h"
 #include "UTCharacter.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerState.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Server Position Checks"), STAT_NetcodePlus_PositionChecks, STATGROUP_NetcodePlus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Server Position Corrections"), STAT_NetcodePlus_PositionCorrections, STATGROUP_NetcodePlus);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Position Error Tolerance (sum)"), STAT_NetcodePlus_PositionTolerance, STATGROUP_NetcodePlus);
 
 UTeamArenaCharacterMovement::UTeamArenaCharacterMovement(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
 {
+    bInParentMovementTick = false;
+    bConfiguredForceTeamCollision = false;
+    bRosterForceTeamCollision = false;
+
     // --- HIGH-FPS FIX #1: Increase position error tolerance ---
     MaxPositionErrorSquared = 10.f;
 
-    // --- Throttle settings ---
-    TeamCollisionUpdateInterval = 0.1f;  // 10 updates/sec instead of 480
-    LastTeamCollisionUpdateTime = -1.0f;  // Force immediate first update
-
     // --- HIGH-FPS FIX #2: Dodge timing tolerance ---
     // Prevents server rejection when client/server timestamps differ by microseconds
     DodgeCooldownTolerance = 0.05f;
+    MinDodgeCooldownTolerance = 0.002f;
+    DodgeDriftJitterScale = 3.0f;
+    ClockDriftRate = 0.0f;
+    ClockDriftJitter = 0.0f;
+    DriftWindowClientStart = -1.0f;
+    DriftWindowServerStart = -1.0f;
+    NumDriftWindows = 0;
+
+    // --- HIGH-FPS FIX #5: Bound the ServerMove rate ---
+    // A 480 FPS client otherwise sends (or tries to) a move per frame
+    MaxServerMoveRate = 120.0f;
+    bFireBoundaryPending = false;
+
+    // --- HIGH-FPS FIX #6: Adaptive position error tolerance ---
+    bAdaptivePositionErrorTolerance = true;
+    MinPositionErrorTolerance = FMath::Sqrt(MaxPositionErrorSquared);
+    MaxPositionErrorTolerance = 10.0f;
+    PositionErrorStdDevScale = 3.0f;
+    PositionErrorPingScale = 0.01f;
+    PositionErrorVelocityScale = 0.002f;
+    PositionErrorMean = 0.0f;
+    PositionErrorStdDev = 0.0f;
+    PositionErrorVariance = 0.0f;
+    CurrentPositionErrorTolerance = MinPositionErrorTolerance;
+    NumPositionChecks = 0;
+    NumPositionCorrections = 0;
 }
 
 void UTeamArenaCharacterMovement::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
-    // --- HIGH-FPS FIX #3: Throttle team collision updates ---
+    // --- HIGH-FPS FIX #3: Event-driven team collision ---
     // Epic's code runs GetPawnIterator() + IgnoreActorWhenMoving() EVERY TICK
-    // At 480 FPS with 8 players = 30,720 calls/sec. We reduce to ~32 calls/sec.
+    // At 480 FPS with 8 players = 30,720 calls/sec. The ignore lists are now kept
+    // up to date by FTeamArenaCollisionRoster when a character spawns/dies/changes team.
     
     // Temporarily force team collision flag to skip Epic's per-tick iterator
-    bool bOriginalForceTeamCollision = bForceTeamCollision;
+    bConfiguredForceTeamCollision = bForceTeamCollision;
     bForceTeamCollision = true;
+    bInParentMovementTick = true;
     
     // Call parent tick (which now skips the expensive iterator)
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
     
     // Restore original value
-    bForceTeamCollision = bOriginalForceTeamCollision;
+    bInParentMovementTick = false;
+    bForceTeamCollision = bConfiguredForceTeamCollision;
     
-    // Now do our throttled team collision update
-    if (!bForceTeamCollision)
+    // Only does work if a roster event arrived before the game state (client join), or the
+    // game's bTeamCollision or our bForceTeamCollision changed since the ignores were set
+    FTeamArenaCollisionRoster& Roster = FTeamArenaCollisionRoster::Get(GetWorld());
+    if (bConfiguredForceTeamCollision != bRosterForceTeamCollision)
+    {
+        bRosterForceTeamCollision = bConfiguredForceTeamCollision;
+        Roster.MarkNeedsRefresh();
+    }
+    Roster.CheckTeamCollisionSetting();
+    if (Roster.NeedsRefresh())
     {
-        const float WorldTime = GetWorld()->GetTimeSeconds();
-        if (WorldTime - LastTeamCollisionUpdateTime >= TeamCollisionUpdateInterval)
-        {
-            LastTeamCollisionUpdateTime = WorldTime;
-            UpdateTeamCollisionIgnores();
-        }
+        Roster.RefreshAll();
     }
 }
 
-void UTeamArenaCharacterMovement::UpdateTeamCollisionIgnores()
+void UTeamArenaCharacterMovement::SimulateMovement(float DeltaTime)
 {
-    AUTCharacter* UTOwner = Cast<AUTCharacter>(CharacterOwner);
-    if (!UTOwner)
+    // Snapshot interpolation mode: the proxy is placed from its buffer, not simulated forward
+    ATeamArenaCharacter* TAC = Cast<ATeamArenaCharacter>(CharacterOwner);
+    if (TAC && TAC->ApplySnapshotInterpolation(DeltaTime))
     {
         return;
     }
 
-    AUTGameState* GS = GetWorld()->GetGameState<AUTGameState>();
-    if (!GS || GS->bTeamCollision)
+    Super::SimulateMovement(DeltaTime);
+}
+
+float UTeamArenaCharacterMovement::GetClientNetSendDeltaTime(const APlayerController* PC, const FNetworkPredictionData_Client_Character* ClientData, const FSavedMovePtr& NewMove) const
+{
+    // Never send faster than MaxServerMoveRate; Super may ask for slower (low net speed)
+    const float NetSendDelta = Super::GetClientNetSendDeltaTime(PC, ClientData, NewMove);
+    return (MaxServerMoveRate > 0.f) ? FMath::Max(NetSendDelta, 1.f / MaxServerMoveRate) : NetSendDelta;
+}
+
+bool UTeamArenaCharacterMovement::CanDelaySendingMove(const FSavedMovePtr& NewMove)
+{
+    // Boundaries the server has to see exactly when they happened
+    if (bFireBoundaryPending)
     {
+        bFireBoundaryPending = false;
+        return false;
+    }
+
+    // Jump/dodge and the other one-shot flags. Crouch is held, so it doesn't count.
+    if (NewMove.IsValid() && (NewMove->GetCompressedFlags() & ~FSavedMove_Character::FLAG_WantsToCrouch) != 0)
+    {
+        return false;
+    }
+
+    return Super::CanDelaySendingMove(NewMove);
+}
+
+float UTeamArenaCharacterMovement::UpdatePositionErrorTolerance(float Error)
+{
+    // Only errors a legit client can produce go into the distribution,
+    // so a cheater (or a real desync) can't widen their own tolerance
+    if (Error < 2.0f * MaxPositionErrorTolerance)
+    {
+        const float Alpha = (NumPositionChecks < 100) ? 1.0f / (NumPositionChecks + 1) : 0.01f;
+        const float Delta = Error - PositionErrorMean;
+        PositionErrorMean += Alpha * Delta;
+        PositionErrorVariance = (1.0f - Alpha) * (PositionErrorVariance + Alpha * Delta * Delta);
+        PositionErrorStdDev = FMath::Sqrt(PositionErrorVariance);
+    }
+    NumPositionChecks++;
+
+    const APlayerState* PS = CharacterOwner ? CharacterOwner->PlayerState : nullptr;
+    const float PingMs = PS ? PS->ExactPing : 0.0f;
+
+    const float Tolerance = PositionErrorMean + PositionErrorStdDevScale * PositionErrorStdDev
+        + PositionErrorPingScale * PingMs
+        + PositionErrorVelocityScale * Velocity.Size();
+
+    return FMath::Clamp(Tolerance, MinPositionErrorTolerance, MaxPositionErrorTolerance);
+}
+
+bool UTeamArenaCharacterMovement::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+    INC_DWORD_STAT(STAT_NetcodePlus_PositionChecks);
+    UpdateClockDrift(ClientTimeStamp);
+
+    if (bAdaptivePositionErrorTolerance && UpdatedComponent)
+    {
+        const float Error = (UpdatedComponent->GetComponentLocation() - ClientWorldLocation).Size();
+        CurrentPositionErrorTolerance = UpdatePositionErrorTolerance(Error);
+        MaxPositionErrorSquared = FMath::Square(CurrentPositionErrorTolerance);
+        INC_FLOAT_STAT_BY(STAT_NetcodePlus_PositionTolerance, CurrentPositionErrorTolerance);
+    }
+
+    // UUTCharacterMovement compares against MaxPositionErrorSquared, so Super only corrects past our threshold
+    const bool bNeedsCorrection = Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+    if (bNeedsCorrection)
+    {
+        NumPositionCorrections++;
+        INC_DWORD_STAT(STAT_NetcodePlus_PositionCorrections);
+    }
+    return bNeedsCorrection;
+}
+
+void UTeamArenaCharacterMovement::NotifyFireBoundary()
+{
+    if (CharacterOwner && CharacterOwner->Role == ROLE_AutonomousProxy)
+    {
+        FlushServerMoves();
+        bFireBoundaryPending = true;
+    }
+}
+
+void UTeamArenaCharacterMovement::UpdateClockDrift(float ClientTimeStamp)
+{
+    // Compare how far the client's movement clock advanced against ours over ~1 second windows.
+    // Long windows average out packet arrival jitter; what's left is real clock drift.
+    const float ServerTime = GetWorld()->GetRealTimeSeconds();
+
+    // First sample, or the client reset its timestamps (UE does this every few minutes)
+    if (DriftWindowClientStart < 0.0f || ClientTimeStamp < DriftWindowClientStart)
+    {
+        DriftWindowClientStart = ClientTimeStamp;
+        DriftWindowServerStart = ServerTime;
         return;
     }
 
-    UPrimitiveComponent* Capsule = Cast<UPrimitiveComponent>(UpdatedComponent);
-    if (!Capsule)
+    const float ServerDelta = ServerTime - DriftWindowServerStart;
+    if (ServerDelta < 1.0f)
     {
         return;
     }
 
-    // This is Epic's original logic, just not running 480 times per second
-    for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
+    const float ClientDelta = ClientTimeStamp - DriftWindowClientStart;
+    const float WindowRate = (ClientDelta / ServerDelta) - 1.0f;
+
+    // A stall (hitch, packet loss burst) shows up as a wild rate - don't learn from it
+    if (FMath::Abs(WindowRate) < 0.05f)
     {
-        AUTCharacter* Char = It->IsValid() ? Cast<AUTCharacter>((*It).Get()) : nullptr;
-        if (Char)
-        {
-            bool bShouldIgnore = GS->OnSameTeam(UTOwner, Char) && 
-                                 (UTOwner != Char) && 
-                                 !Char->IsPendingKillPending() && 
-                                 !Char->IsDead() && 
-                                 !Char->IsRagdoll();
-            Capsule->IgnoreActorWhenMoving(Char, bShouldIgnore);
-        }
+        const float Alpha = (NumDriftWindows < 10) ? 1.0f / (NumDriftWindows + 1) : 0.1f;
+        const float WindowError = FMath::Abs(ClientDelta - ServerDelta * (1.0f + ClockDriftRate));
+        ClockDriftRate += Alpha * (WindowRate - ClockDriftRate);
+        ClockDriftJitter += Alpha * (WindowError - ClockDriftJitter);
+        NumDriftWindows++;
     }
+
+    DriftWindowClientStart = ClientTimeStamp;
+    DriftWindowServerStart = ServerTime;
+}
+
+float UTeamArenaCharacterMovement::GetDodgeCooldownTolerance() const
+{
+    // Not enough data yet - keep the old fixed slack
+    if (NumDriftWindows < 3)
+    {
+        return DodgeCooldownTolerance;
+    }
+
+    // The cooldown is measured in the client's movement clock (GetCurrentMovementTime is the client's
+    // move timestamp during ServerMove), so only drift over the cooldown and timing noise need slack.
+    // Never more than the old fixed value, so the exploit window can't grow.
+    const float DriftSlack = FMath::Abs(ClockDriftRate) * DodgeResetInterval + DodgeDriftJitterScale * ClockDriftJitter;
+    return FMath::Clamp(DriftSlack, MinDodgeCooldownTolerance, DodgeCooldownTolerance);
 }
 
 bool UTeamArenaCharacterMovement::CanDodge()
@@ -98,7 +245,7 @@ bool UTeamArenaCharacterMovement::CanDodge()
     {
         // Only apply tolerance on server/authority
         // This way client predicts at exact timing, server accepts with tolerance
-        Tolerance = DodgeCooldownTolerance;
+        Tolerance = GetDodgeCooldownTolerance();
     }
 
     return !bIsFloorSliding && 
@@ -0,0 +1,158 @@
+// TeamArenaCollisionRoster.cpp
+
+#include "TeamArenaCollisionRoster.h"
+#include "UTCharacter.h"
+#include "UTCharacterMovement.h"
+#include "TeamArenaCharacterMovement.h"
+#include "UTGameState.h"
+#include "Engine/World.h"
+
+TMap<TWeakObjectPtr<UWorld>, TSharedPtr<FTeamArenaCollisionRoster>> FTeamArenaCollisionRoster::Rosters;
+FDelegateHandle FTeamArenaCollisionRoster::WorldCleanupHandle;
+
+FTeamArenaCollisionRoster& FTeamArenaCollisionRoster::Get(UWorld* World)
+{
+    TSharedPtr<FTeamArenaCollisionRoster>& Roster = Rosters.FindOrAdd(World);
+    if (!Roster.IsValid())
+    {
+        Roster = MakeShareable(new FTeamArenaCollisionRoster(World));
+    }
+    return *Roster;
+}
+
+FTeamArenaCollisionRoster* FTeamArenaCollisionRoster::Find(UWorld* World)
+{
+    TSharedPtr<FTeamArenaCollisionRoster>* Roster = Rosters.Find(World);
+    return (Roster && Roster->IsValid()) ? Roster->Get() : nullptr;
+}
+
+void FTeamArenaCollisionRoster::RegisterWorldDelegates()
+{
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FTeamArenaCollisionRoster::OnWorldCleanup);
+}
+
+void FTeamArenaCollisionRoster::UnregisterWorldDelegates()
+{
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    Rosters.Empty();
+}
+
+void FTeamArenaCollisionRoster::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    Rosters.Remove(World);
+}
+
+/** A character whose movement forces team collision is blocked by teammates when it moves */
+static bool IsTeamCollisionForced(const AUTCharacter* Char)
+{
+    const UTeamArenaCharacterMovement* TeamMovement = Cast<UTeamArenaCharacterMovement>(Char->UTCharacterMovement);
+    if (TeamMovement)
+    {
+        return TeamMovement->IsTeamCollisionForced();
+    }
+    return Char->UTCharacterMovement && Char->UTCharacterMovement->bForceTeamCollision;
+}
+
+bool FTeamArenaCollisionRoster::ShouldIgnore(const AUTGameState* GS, const AUTCharacter* Self, const AUTCharacter* Other)
+{
+    return GS && !GS->bTeamCollision &&
+           (Self != Other) &&
+           !IsTeamCollisionForced(Self) &&
+           GS->OnSameTeam(Self, Other) &&
+           !Other->IsPendingKillPending() && !Other->IsDead() && !Other->IsRagdoll();
+}
+
+void FTeamArenaCollisionRoster::UpdatePair(const AUTGameState* GS, AUTCharacter* A, AUTCharacter* B)
+{
+    // One-way, like the per-component loop: a forced character bumps into teammates, but they
+    // still pass through it unless they force collision too
+    A->GetCapsuleComponent()->IgnoreActorWhenMoving(B, ShouldIgnore(GS, A, B));
+    B->GetCapsuleComponent()->IgnoreActorWhenMoving(A, ShouldIgnore(GS, B, A));
+}
+
+void FTeamArenaCollisionRoster::NotifyCharacterChanged(AUTCharacter* Char)
+{
+    if (Char == nullptr || Char->GetCapsuleComponent() == nullptr)
+    {
+        return;
+    }
+
+    Members.AddUnique(Char);
+
+    UWorld* MyWorld = World.Get();
+    AUTGameState* GS = MyWorld ? MyWorld->GetGameState<AUTGameState>() : nullptr;
+    if (GS == nullptr)
+    {
+        // Client before the game state replicated - catch up on the first movement tick that has it
+        bNeedsRefresh = true;
+        return;
+    }
+
+    for (int32 i = Members.Num() - 1; i >= 0; i--)
+    {
+        AUTCharacter* Other = Members[i].Get();
+        if (Other == nullptr)
+        {
+            Members.RemoveAtSwap(i, 1, false);
+        }
+        else if (Other != Char)
+        {
+            UpdatePair(GS, Char, Other);
+        }
+    }
+}
+
+void FTeamArenaCollisionRoster::RemoveCharacter(AUTCharacter* Char)
+{
+    if (Char == nullptr)
+    {
+        return;
+    }
+
+    Members.RemoveSwap(Char);
+
+    for (int32 i = Members.Num() - 1; i >= 0; i--)
+    {
+        AUTCharacter* Other = Members[i].Get();
+        if (Other == nullptr)
+        {
+            Members.RemoveAtSwap(i, 1, false);
+        }
+        else if (Other->GetCapsuleComponent())
+        {
+            Other->GetCapsuleComponent()->IgnoreActorWhenMoving(Char, false);
+        }
+    }
+}
+
+void FTeamArenaCollisionRoster::RefreshAll()
+{
+    UWorld* MyWorld = World.Get();
+    AUTGameState* GS = MyWorld ? MyWorld->GetGameState<AUTGameState>() : nullptr;
+    if (GS == nullptr)
+    {
+        return;
+    }
+    bNeedsRefresh = false;
+    bRefreshedTeamCollision = GS->bTeamCollision;
+    bHasRefreshedTeamCollision = true;
+
+    Members.RemoveAllSwap([](const TWeakObjectPtr<AUTCharacter>& Member) { return !Member.IsValid(); });
+    for (int32 i = 0; i < Members.Num(); i++)
+    {
+        for (int32 j = i + 1; j < Members.Num(); j++)
+        {
+            UpdatePair(GS, Members[i].Get(), Members[j].Get());
+        }
+    }
+}
+
+void FTeamArenaCollisionRoster::CheckTeamCollisionSetting()
+{
+    UWorld* MyWorld = World.Get();
+    AUTGameState* GS = MyWorld ? MyWorld->GetGameState<AUTGameState>() : nullptr;
+    if (GS && (!bHasRefreshedTeamCollision || GS->bTeamCollision != bRefreshedTeamCollision))
+    {
+        bNeedsRefresh = true;
+    }
+}
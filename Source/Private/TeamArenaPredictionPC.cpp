@@ -4,6 +4,10 @@
 #include "TeamArenaCharacter.h"
 #include "UTWeaponFix.h"
 #include "UTPlayerState.h"
+#include "NetcodePlusRpcStats.h"
+#include "NetcodePlusNetDiagnostics.h"
+#include "TeamArenaCharacterMovement.h"
+#include "Debug/DebugDrawService.h"
 
 
 ATeamArenaPredictionPC::ATeamArenaPredictionPC(const FObjectInitializer& ObjectInitializer)
@@ -21,6 +25,14 @@ ATeamArenaPredictionPC::ATeamArenaPredictionPC(const FObjectInitializer& ObjectI
     CurrentHitValidation = 0.12f;            // 120ms in seconds
     PredictionSmoothingFactor_X = 0.1f;        // Smooth over ~10 frames
 
+    ReportedProxyInterpDelay = 0.0f;
+    LastSentProxyInterpDelayMs = 0;
+    LastProxyInterpDelayReportTime = 0.0f;
+
+    NetDiagnosticsInterval = 0.5f;           // 2Hz overlay stats
+    bNetDiagnosticsSubscribed = false;
+    bNetDiagnosticsOverlay = false;
+    LastNetDiagnosticsReceiveTime = -1.0f;
 
 }
 
@@ -79,3 +91,201 @@ float ATeamArenaPredictionPC::GetHitValidationTime() const
     return GetHitValidationTime();
 }*/
 
+
+
+bool ATeamArenaPredictionPC::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+    FNetcodePlusRpcStats::FScope RpcStatsScope(this, Function);
+    return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
+void ATeamArenaPredictionPC::PlayerTick(float DeltaTime)
+{
+    Super::PlayerTick(DeltaTime);
+
+    // --- NET DIAGNOSTICS OVERLAY: follow np.NetDiag (a single cvar read while it's off) ---
+    if (IsLocalController() && FNetcodePlusNetDiagnostics::IsOverlayRequested() != bNetDiagnosticsOverlay)
+    {
+        SetNetDiagnosticsOverlay(!bNetDiagnosticsOverlay);
+    }
+
+    // --- SNAPSHOT INTERPOLATION: report our render delay so the server rewinds to what we drew ---
+    if (!IsLocalController() || HasAuthority())
+    {
+        return;
+    }
+
+    const float WorldTime = GetWorld()->GetTimeSeconds();
+    if (WorldTime - LastProxyInterpDelayReportTime < 0.5f)
+    {
+        return;
+    }
+    LastProxyInterpDelayReportTime = WorldTime;
+
+    float DelaySum = 0.0f;
+    int32 NumProxies = 0;
+    for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
+    {
+        ATeamArenaCharacter* TAC = Cast<ATeamArenaCharacter>(It->Get());
+        if (TAC && TAC->UsesSnapshotInterpolation())
+        {
+            DelaySum += TAC->GetSnapshotRenderDelay();
+            NumProxies++;
+        }
+    }
+
+    const uint16 DelayMs = (NumProxies > 0) ? (uint16)FMath::RoundToInt(1000.0f * DelaySum / NumProxies) : 0;
+    if (FMath::Abs((int32)DelayMs - (int32)LastSentProxyInterpDelayMs) >= 2 || (DelayMs == 0 && LastSentProxyInterpDelayMs != 0))
+    {
+        LastSentProxyInterpDelayMs = DelayMs;
+        ServerSetProxyInterpDelay(DelayMs);
+    }
+}
+
+bool ATeamArenaPredictionPC::ServerSetProxyInterpDelay_Validate(uint16 DelayMs)
+{
+    return true;
+}
+
+void ATeamArenaPredictionPC::ServerSetProxyInterpDelay_Implementation(uint16 DelayMs)
+{
+    // Clamped to the most any proxy is allowed to lag. The proxies this client draws share our
+    // pawn's class in practice; fall back to the class default while we have no pawn.
+    const ATeamArenaCharacter* TeamChar = Cast<ATeamArenaCharacter>(GetPawn());
+    const float MaxDelay = (TeamChar ? TeamChar : GetDefault<ATeamArenaCharacter>())->MaxSnapshotInterpDelay;
+    ReportedProxyInterpDelay = FMath::Min(DelayMs * 0.001f, MaxDelay);
+}
+
+void ATeamArenaPredictionPC::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (bNetDiagnosticsOverlay)
+    {
+        UDebugDrawService::Unregister(NetDiagnosticsDrawHandle);
+        NetDiagnosticsDrawHandle.Reset();
+        FNetcodePlusNetDiagnostics::SetOverlayActive(false);
+        bNetDiagnosticsOverlay = false;
+    }
+    SetNetDiagnosticsSubscribed(false);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ATeamArenaPredictionPC::SetNetDiagnosticsOverlay(bool bEnabled)
+{
+    bNetDiagnosticsOverlay = bEnabled;
+    FNetcodePlusNetDiagnostics::SetOverlayActive(bEnabled);
+    NetDiagnosticsLines.Reset();
+    LastNetDiagnosticsReceiveTime = -1.0f;
+
+    if (bEnabled)
+    {
+        NetDiagCounters.Reset();
+        NetDiagnosticsDrawHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateUObject(this, &ATeamArenaPredictionPC::DrawNetDiagnostics));
+    }
+    else
+    {
+        UDebugDrawService::Unregister(NetDiagnosticsDrawHandle);
+        NetDiagnosticsDrawHandle.Reset();
+    }
+    ServerSetNetDiagnosticsEnabled(bEnabled);
+}
+
+bool ATeamArenaPredictionPC::ServerSetNetDiagnosticsEnabled_Validate(bool bEnabled)
+{
+    return true;
+}
+
+void ATeamArenaPredictionPC::ServerSetNetDiagnosticsEnabled_Implementation(bool bEnabled)
+{
+    SetNetDiagnosticsSubscribed(bEnabled);
+}
+
+void ATeamArenaPredictionPC::SetNetDiagnosticsSubscribed(bool bEnabled)
+{
+    if (bEnabled == bNetDiagnosticsSubscribed)
+    {
+        return;
+    }
+    bNetDiagnosticsSubscribed = bEnabled;
+
+    if (bEnabled)
+    {
+        FNetcodePlusNetDiagnostics::AddSubscriber();
+        NetDiagCounters.Reset();
+        GetWorldTimerManager().SetTimer(NetDiagnosticsTimerHandle, this, &ATeamArenaPredictionPC::PushNetDiagnostics, FMath::Clamp(NetDiagnosticsInterval, 0.5f, 1.0f), true);
+    }
+    else
+    {
+        FNetcodePlusNetDiagnostics::RemoveSubscriber();
+        GetWorldTimerManager().ClearTimer(NetDiagnosticsTimerHandle);
+    }
+}
+
+void ATeamArenaPredictionPC::PushNetDiagnostics()
+{
+    const float Now = GetWorld()->GetTimeSeconds();
+    const int32 Bucket = NetDiagCounters.Advance(Now);
+
+    // Checks/corrections are running totals on the movement component; bank the deltas since the
+    // last push. A new pawn restarts them, which just skips one sample.
+    ATeamArenaCharacter* TAC = Cast<ATeamArenaCharacter>(GetPawn());
+    UTeamArenaCharacterMovement* Movement = TAC ? Cast<UTeamArenaCharacterMovement>(TAC->GetCharacterMovement()) : nullptr;
+    if (Movement)
+    {
+        if (NetDiagCounters.LastNumPositionChecks >= 0 && Movement->NumPositionChecks >= NetDiagCounters.LastNumPositionChecks
+            && Movement->NumPositionCorrections >= NetDiagCounters.LastNumPositionCorrections)
+        {
+            uint16& Checks = NetDiagCounters.PositionChecks[Bucket];
+            uint16& Corrections = NetDiagCounters.PositionCorrections[Bucket];
+            Checks = (uint16)FMath::Min<int32>(Checks + Movement->NumPositionChecks - NetDiagCounters.LastNumPositionChecks, MAX_uint16);
+            Corrections = (uint16)FMath::Min<int32>(Corrections + Movement->NumPositionCorrections - NetDiagCounters.LastNumPositionCorrections, MAX_uint16);
+        }
+        NetDiagCounters.LastNumPositionChecks = Movement->NumPositionChecks;
+        NetDiagCounters.LastNumPositionCorrections = Movement->NumPositionCorrections;
+    }
+    else
+    {
+        NetDiagCounters.LastNumPositionChecks = -1;
+        NetDiagCounters.LastNumPositionCorrections = -1;
+    }
+
+    FNetcodePlusNetDiagSnapshot Snapshot;
+    Snapshot.ServerTime = Now;
+    NetDiagCounters.Fill(Snapshot);
+    ClientReceiveNetDiagnostics(Snapshot);
+}
+
+void ATeamArenaPredictionPC::ClientReceiveNetDiagnostics_Implementation(FNetcodePlusNetDiagSnapshot Snapshot)
+{
+    if (!bNetDiagnosticsOverlay)
+    {
+        return; // push that crossed our "off"
+    }
+
+    // Clock offset: where the server clock is now (its stamp plus half a round trip) against our
+    // GetServerWorldTimeSeconds() estimate, which is what ServerStartFireFixed timestamps use.
+    // Positive = our estimate runs behind the server.
+    float ClockOffsetMs = 0.0f;
+    AGameStateBase* GS = GetWorld()->GetGameState();
+    if (GS && PlayerState)
+    {
+        const float RTT = (PlayerState->ExactPing > 0.0f) ? PlayerState->ExactPing * 0.001f : PlayerState->Ping * 0.004f;
+        ClockOffsetMs = (Snapshot.ServerTime + 0.5f * RTT - GS->GetServerWorldTimeSeconds()) * 1000.0f;
+    }
+
+    const float Now = GetWorld()->GetTimeSeconds();
+    NetDiagCounters.Advance(Now);
+    FNetcodePlusNetDiagnostics::BuildOverlayLines(Snapshot, NetDiagCounters, ClockOffsetMs, NetDiagnosticsLines);
+    LastNetDiagnosticsReceiveTime = Now;
+}
+
+void ATeamArenaPredictionPC::DrawNetDiagnostics(UCanvas* Canvas, APlayerController* PC)
+{
+    // The game viewport passes no controller; anything else must be us
+    if (PC != nullptr && PC != this)
+    {
+        return;
+    }
+    const float StatsAge = (LastNetDiagnosticsReceiveTime >= 0.0f) ? GetWorld()->GetTimeSeconds() - LastNetDiagnosticsReceiveTime : 0.0f;
+    FNetcodePlusNetDiagnostics::DrawOverlay(Canvas, NetDiagnosticsLines, StatsAge);
+}
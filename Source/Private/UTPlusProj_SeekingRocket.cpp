@@ -0,0 +1,58 @@
+#include "UTPlusProj_SeekingRocket.h"
+#include "UTPlusWeap_RocketLauncher.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+AUTPlusProj_SeekingRocket::AUTPlusProj_SeekingRocket(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    LastHomingFrame = 0;
+}
+
+void AUTPlusProj_SeekingRocket::Tick(float DeltaTime)
+{
+    // Launcher's Tick normally runs first (tick prerequisite), but it can be skipped (weapon
+    // put away, tick disabled). Run its pass for it then, so the batch still covers every rocket.
+    AUTPlusWeap_RocketLauncher* Launcher = HomingLauncher.Get();
+    if (!HasHomedThisFrame() && Launcher && Launcher->Role == ROLE_Authority && !Launcher->IsPendingKillPending())
+    {
+        Launcher->UpdateTrackingRockets(DeltaTime);
+    }
+
+    if (HasHomedThisFrame())
+    {
+        // Launcher already steered us this frame (it ticks first, see FireRocketProjectile).
+        // Skip AUTProj_Rocket::Tick so the stock per-rocket homing doesn't run on top of it.
+        AUTProjectile::Tick(DeltaTime);
+        return;
+    }
+
+    // No launcher pass this frame (client copy, the launcher is gone, or it stopped tracking us) -
+    // home ourselves like a stock rocket
+    Super::Tick(DeltaTime);
+    LastHomingFrame = GFrameCounter;
+}
+
+void AUTPlusProj_SeekingRocket::ApplyHoming(const FVector& AimLocation, float DeltaTime)
+{
+    LastHomingFrame = GFrameCounter;
+    SteerRocket(this, AimLocation, AdjustmentSpeed, DeltaTime);
+}
+
+void AUTPlusProj_SeekingRocket::SteerRocket(AUTProj_Rocket* Rocket, const FVector& AimLocation, float InAdjustmentSpeed, float DeltaTime)
+{
+    if (Rocket->TargetActor == nullptr || Rocket->ProjectileMovement == nullptr)
+    {
+        return;
+    }
+
+    const FVector WantedDir = (AimLocation - Rocket->GetActorLocation()).GetSafeNormal();
+
+    Rocket->ProjectileMovement->Velocity += WantedDir * InAdjustmentSpeed * DeltaTime;
+    Rocket->ProjectileMovement->Velocity = Rocket->ProjectileMovement->Velocity.GetSafeNormal() * Rocket->ProjectileMovement->MaxSpeed;
+
+    // If the rocket has passed the target stop following
+    if (FVector::DotProduct(WantedDir, Rocket->ProjectileMovement->Velocity) < 0.0f)
+    {
+        Rocket->TargetActor = nullptr;
+    }
+}
@@ -1,6 +1,7 @@
 
 #include "UTPlusProj_ShockBall.h"
 #include "UTPlusShockRifle.h"
+#include "NetcodePlusStats.h"
 #include "Particles/ParticleSystemComponent.h"
 
 
@@ -10,6 +11,10 @@ AUTPlusProj_ShockBall::AUTPlusProj_ShockBall(const FObjectInitializer& ObjectIni
 	FlightEffectVisual = nullptr;
 	bVisualInitialized = false; // Start as false
 	VisualInterpSpeed = 100.0f;
+
+	PositionSaveRate = 60.0f;
+	MaxSavedPositionAge = 0.35f;
+	LastPositionSaveTime = -1.0f;
 }
 
 void AUTPlusProj_ShockBall::PerformCombo(class AController* InstigatedBy, class AActor* DamageCauser)
@@ -52,15 +57,86 @@ void AUTPlusProj_ShockBall::BeginPlay()
 {
 	Super::BeginPlay();
 
-
+	if (Role == ROLE_Authority)
+	{
+		SavePosition();
+	}
 }
 
 
 
+void AUTPlusProj_ShockBall::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	NETCODEPLUS_GAUGE_UPDATE(STAT_NetcodePlus_ShockBallHistory, ShockBallHistory, SavedPositions.Num(), 0);
+	SavedPositions.Empty();
+	Super::EndPlay(EndPlayReason);
+}
+
 void AUTPlusProj_ShockBall::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (Role == ROLE_Authority && !bExploded)
+	{
+		SavePosition();
+	}
+}
+
+void AUTPlusProj_ShockBall::SavePosition()
+{
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+	if (LastPositionSaveTime >= 0.0f && (WorldTime - LastPositionSaveTime) < 1.0f / FMath::Max(PositionSaveRate, 1.0f))
+	{
+		return;
+	}
+	LastPositionSaveTime = WorldTime;
+	const int32 OldHistorySize = SavedPositions.Num();
+
+	SavedPositions.Add(FShockBallSavedPosition(GetActorLocation(), WorldTime));
+
+	// Keep one position beyond MaxSavedPositionAge for interpolation
+	while (SavedPositions.Num() > 1 && SavedPositions[1].Time < WorldTime - MaxSavedPositionAge)
+	{
+		SavedPositions.RemoveAt(0, 1, false);
+	}
+	NETCODEPLUS_GAUGE_UPDATE(STAT_NetcodePlus_ShockBallHistory, ShockBallHistory, OldHistorySize, SavedPositions.Num());
+}
+
+FVector AUTPlusProj_ShockBall::GetRewindLocation(float PredictionTime) const
+{
+	if (PredictionTime <= 0.0f || SavedPositions.Num() == 0)
+	{
+		return GetActorLocation();
+	}
+
+	const float TargetTime = GetWorld()->GetTimeSeconds() - PredictionTime;
+
+	// Before the first save the ball didn't exist on the server yet - use where it started
+	if (TargetTime <= SavedPositions[0].Time)
+	{
+		return SavedPositions[0].Position;
+	}
+
+	for (int32 i = SavedPositions.Num() - 1; i >= 0; i--)
+	{
+		if (SavedPositions[i].Time < TargetTime)
+		{
+			const FVector PostPosition = (i < SavedPositions.Num() - 1) ? SavedPositions[i + 1].Position : GetActorLocation();
+			const float PostTime = (i < SavedPositions.Num() - 1) ? SavedPositions[i + 1].Time : GetWorld()->GetTimeSeconds();
+			if (PostTime <= SavedPositions[i].Time)
+			{
+				return PostPosition;
+			}
+			const float Percent = (TargetTime - SavedPositions[i].Time) / (PostTime - SavedPositions[i].Time);
+			return SavedPositions[i].Position + Percent * (PostPosition - SavedPositions[i].Position);
+		}
+	}
+	return GetActorLocation();
+}
+
+float AUTPlusProj_ShockBall::GetComboHitRadius() const
+{
+	return CollisionComp ? CollisionComp->GetScaledSphereRadius() : 0.0f;
 }
 
 
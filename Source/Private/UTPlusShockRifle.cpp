@@ -1,6 +1,8 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 #include "UTPlusShockRifle.h"
 #include "UTProj_ShockBall.h"
+#include "UTPlusProj_ShockBall.h"
+#include "EngineUtils.h"
 #include "UTCanvasRenderTarget2D.h"
 #include "StatNames.h"
 #include "Core.h"
@@ -25,6 +27,7 @@ AUTPlusShockRifle::AUTPlusShockRifle(const FObjectInitializer& ObjectInitializer
 	BasePickupDesireability = 0.65f;
 	ScreenMaterialID = 5;
 	LastClientKillTime = -100000.0f;
+	ScreenComponent = ObjectInitializer.CreateDefaultSubobject<UUTPlusWeaponScreenComponent>(this, TEXT("ScreenComponent"));
 	bFPIgnoreInstantHitFireOffset = false;
 	FOVOffset = FVector(0.6f, 0.9f, 1.2f);
 
@@ -71,10 +74,8 @@ void AUTPlusShockRifle::SetupSpecialMaterials()
 	if (!IsRunningDedicatedServer() && Mesh != NULL && ScreenMaterialID < Mesh->GetNumMaterials())
 	{
 		ScreenMI = Mesh->CreateAndSetMaterialInstanceDynamic(ScreenMaterialID);
-		ScreenTexture = UCanvasRenderTarget2D::CreateCanvasRenderTarget2D(this, UCanvasRenderTarget2D::StaticClass(), 64, 64);
-		ScreenTexture->ClearColor = FLinearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		ScreenTexture = ScreenComponent->CreateScreenTexture(Mesh, ScreenMI);
 		ScreenTexture->OnCanvasRenderTargetUpdate.AddDynamic(this, &AUTPlusShockRifle::UpdateScreenTexture);
-		ScreenMI->SetTextureParameterValue(FName(TEXT("ScreenTexture")), ScreenTexture);
 	}
 }
 
@@ -122,9 +123,20 @@ void AUTPlusShockRifle::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (ScreenTexture != NULL && Mesh->IsRegistered() && GetWorld()->TimeSeconds - Mesh->LastRenderTime < 0.1f)
+	// --- SCREEN: redraw only when what it shows changes (ammo, kill-notify window) ---
+	if (ScreenTexture != NULL)
 	{
-		ScreenTexture->FastUpdateResource();
+		bool bInfiniteAmmo = true;
+		for (int32 Cost : AmmoCost)
+		{
+			if (Cost > 0)
+			{
+				bInfiniteAmmo = false;
+				break;
+			}
+		}
+		const bool bKillNotify = (GetWorld()->TimeSeconds - LastClientKillTime < 2.5f && ScreenKillNotifyTexture != NULL);
+		ScreenComponent->UpdateScreen(bInfiniteAmmo ? -1 : Ammo, bKillNotify, 0);
 	}
 }
 
@@ -160,6 +172,57 @@ void AUTPlusShockRifle::HitScanTrace(const FVector& StartLocation, const FVector
 	bPlayComboEffects = (Cast<AUTProj_ShockBall>(Hit.GetActor()) != NULL);
 }
 
+void AUTPlusShockRifle::TraceRewoundProjectiles(const FVector& StartLocation, const FVector& EndTrace, float TraceRadius, FHitResult& Hit, float PredictionTime)
+{
+	// World trace already hit a ball where it is now - combo either way
+	if (Cast<AUTProj_ShockBall>(Hit.GetActor()) != NULL)
+	{
+		return;
+	}
+
+	// Only balls in front of whatever the world trace hit count
+	const FVector TraceEnd = Hit.Location;
+	AUTPlusProj_ShockBall* BestBall = NULL;
+	FVector BestPoint(0.f);
+	FVector BestBallLocation(0.f);
+	float BestDistSq = (TraceEnd - StartLocation).SizeSquared();
+
+	for (TActorIterator<AUTPlusProj_ShockBall> It(GetWorld()); It; ++It)
+	{
+		AUTPlusProj_ShockBall* Ball = *It;
+		if (Ball->bExploded || Ball->IsPendingKillPending())
+		{
+			continue;
+		}
+
+		const FVector BallLocation = Ball->GetRewindLocation(PredictionTime);
+		const FVector ClosestPoint = FMath::ClosestPointOnSegment(BallLocation, StartLocation, TraceEnd);
+		if ((ClosestPoint - BallLocation).SizeSquared() < FMath::Square(Ball->GetComboHitRadius() + TraceRadius))
+		{
+			const float DistSq = (ClosestPoint - StartLocation).SizeSquared();
+			if (DistSq <= BestDistSq)
+			{
+				BestBall = Ball;
+				BestPoint = ClosestPoint;
+				BestBallLocation = BallLocation;
+				BestDistSq = DistSq;
+			}
+		}
+	}
+
+	if (BestBall)
+	{
+		Hit.Location = BestPoint;
+		Hit.ImpactPoint = BestPoint;
+		Hit.Normal = (BestPoint - BestBallLocation).GetSafeNormal();
+		Hit.ImpactNormal = Hit.Normal;
+		Hit.Actor = BestBall;
+		Hit.Component = BestBall->CollisionComp;
+		Hit.bBlockingHit = true;
+		Hit.Time = FMath::Sqrt(BestDistSq) / (EndTrace - StartLocation).Size();
+	}
+}
+
 
 void AUTPlusShockRifle::ClientNotifyImpressive_Implementation()
 {
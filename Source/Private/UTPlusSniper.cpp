@@ -114,12 +114,19 @@ void AUTPlusSniper::FireInstantHit(bool bDealDamage, FHitResult* OutHit)
 	// ----------------------------------------------------------------------
 	checkSlow(InstantHitInfo.IsValidIndex(CurrentFireMode));
 
-	const FVector SpawnLocation = GetFireStartLoc();
-	const FRotator SpawnRotation = GetAdjustedAim(SpawnLocation);
+	// Owning client: reuse the trace FireShot sent as the hit claim
+	FVector SpawnLocation;
+	FRotator SpawnRotation;
+	FHitResult Hit;
+	const bool bPreTraced = ConsumeClientPreTrace(SpawnLocation, SpawnRotation, Hit);
+	if (!bPreTraced)
+	{
+		SpawnLocation = GetFireStartLoc();
+		SpawnRotation = GetAdjustedAim(SpawnLocation);
+	}
 	const FVector FireDir = SpawnRotation.Vector();
 	const FVector EndTrace = SpawnLocation + FireDir * InstantHitInfo[CurrentFireMode].TraceRange;
 
-	FHitResult Hit;
 	AUTPlayerController* UTPC = UTOwner ? Cast<AUTPlayerController>(UTOwner->Controller) : NULL;
 	AUTPlayerState* PS = (UTOwner && UTOwner->Controller) ? Cast<AUTPlayerState>(UTOwner->Controller->PlayerState) : NULL;
 
@@ -127,7 +134,10 @@ void AUTPlusSniper::FireInstantHit(bool bDealDamage, FHitResult* OutHit)
 	float PredictionTime = GetHitValidationPredictionTime();
 
 	// This calls UTWeaponFix::HitScanTrace, which now handles the detailed rewinding
-	HitScanTrace(SpawnLocation, EndTrace, InstantHitInfo[CurrentFireMode].TraceHalfSize, Hit, PredictionTime);
+	if (!bPreTraced)
+	{
+		HitScanTrace(SpawnLocation, EndTrace, InstantHitInfo[CurrentFireMode].TraceHalfSize, Hit, PredictionTime);
+	}
 
 
 	
@@ -136,12 +146,14 @@ void AUTPlusSniper::FireInstantHit(bool bDealDamage, FHitResult* OutHit)
 	// PART 3: SNIPER SPECIFIC HEAD SEARCH (Standard UT Sniper logic)
 	// ----------------------------------------------------------------------
 	// Do a second search specifically for the Head Sphere if the capsule miss was close
+	bool bHeadSphereHit = false;
 	if (UTOwner && Cast<AUTCharacter>(Hit.Actor.Get()) == NULL)
 	{
 		AUTCharacter* AltTarget = Cast<AUTCharacter>(UUTGameplayStatics::ChooseBestAimTarget(GetUTOwner()->Controller, SpawnLocation, FireDir, 0.7f, (Hit.Location - SpawnLocation).Size(), 150.0f, AUTCharacter::StaticClass()));
 		if (AltTarget != NULL && AltTarget->IsHeadShot(SpawnLocation, FireDir, GetHeadshotScale(AltTarget), UTOwner, PredictionTime))
 		{
 			Hit = FHitResult(AltTarget, AltTarget->GetCapsuleComponent(), SpawnLocation + FireDir * ((AltTarget->GetHeadLocation() - SpawnLocation).Size() - AltTarget->GetCapsuleComponent()->GetUnscaledCapsuleRadius()), -FireDir);
+			bHeadSphereHit = true;
 		}
 	}
 
@@ -151,6 +163,7 @@ void AUTPlusSniper::FireInstantHit(bool bDealDamage, FHitResult* OutHit)
 	// ----------------------------------------------------------------------
 	if (Role == ROLE_Authority)
 	{
+		RecordHitAudit(Hit, SpawnLocation, EndTrace, PredictionTime, bHeadSphereHit);
 		if (PS && (ShotsStatsName != NAME_None))
 		{
 			PS->ModifyStatsValue(ShotsStatsName, 1);
@@ -14,6 +14,7 @@
 #include "Net/UnrealNetwork.h"
 #include "UTWeaponStateEquipping.h"
 #include "UTProj_Rocket.h"
+#include "UTPlusProj_SeekingRocket.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Animation/AnimMontage.h"
 #include "UTBot.h"
@@ -69,6 +70,8 @@ AUTPlusWeap_RocketLauncher::AUTPlusWeap_RocketLauncher(const FObjectInitializer&
     LockOffset = 800.f;
     bTargetLockingActive = true;
     LastTargetLockCheckTime = 0.0f;
+    SeekingLeadScale = 0.0f;
+    SeekingMaxLeadTime = 0.5f;
 
     // HUD
     CrosshairRotationTime = 0.3f;
@@ -133,6 +136,12 @@ void AUTPlusWeap_RocketLauncher::GetLifetimeReplicatedProps(TArray<FLifetimeProp
 
 void AUTPlusWeap_RocketLauncher::Destroyed()
 {
+    // Rockets still in flight go back to homing themselves
+    while (HandedOffRockets.Num() > 0)
+    {
+        ReleaseRocketHoming(HandedOffRockets.Last().Rocket.Get());
+    }
+
     Super::Destroyed();
     GetWorldTimerManager().ClearAllTimersForObject(this);
 }
@@ -525,6 +534,19 @@ AUTProjectile* AUTPlusWeap_RocketLauncher::FireRocketProjectile()
             {
                 SpawnedRocket->TargetActor = LockedTarget;
                 TrackingRockets.AddUnique(SpawnedRocket);
+
+                // Homing comes from UpdateTrackingRockets. Our seeking rockets skip their own step when
+                // steered (tick first so the batched pass lands before theirs); stock ones hand it off.
+                AUTPlusProj_SeekingRocket* SeekingRocket = Cast<AUTPlusProj_SeekingRocket>(SpawnedRocket);
+                if (SeekingRocket)
+                {
+                    SeekingRocket->HomingLauncher = this;
+                    SeekingRocket->AddTickPrerequisiteActor(this);
+                }
+                else if (Role == ROLE_Authority)
+                {
+                    HandOffRocketHoming(SpawnedRocket);
+                }
             }
         }
 
@@ -934,6 +956,130 @@ void AUTPlusWeap_RocketLauncher::UpdateLock()
     // This is called on a timer to update target lock state
 }
 
+void AUTPlusWeap_RocketLauncher::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Role == ROLE_Authority && TrackingRockets.Num() > 0)
+    {
+        UpdateTrackingRockets(DeltaTime);
+    }
+}
+
+void AUTPlusWeap_RocketLauncher::UpdateTrackingRockets(float DeltaTime)
+{
+    // Per-target data, read once per frame and shared by every rocket chasing that target.
+    // A volley is at most MaxLoadedRockets rockets on one or two targets, so a linear lookup is fine.
+    struct FHomingTarget
+    {
+        AActor* Target;
+        FVector Location;
+        FVector Velocity;
+    };
+    TArray<FHomingTarget, TInlineAllocator<4>> HomingTargets;
+
+    for (int32 i = TrackingRockets.Num() - 1; i >= 0; i--)
+    {
+        AUTProj_Rocket* Rocket = TrackingRockets[i];
+        if (Rocket && Rocket->MasterProjectile)
+        {
+            Rocket = Cast<AUTProj_Rocket>(Rocket->MasterProjectile);
+            TrackingRockets[i] = Rocket;
+        }
+
+        if ((Rocket == nullptr) || Rocket->bExploded || Rocket->IsPendingKillPending() || (Rocket->TargetActor == nullptr) || Rocket->TargetActor->IsPendingKillPending())
+        {
+            ReleaseRocketHoming(Rocket);
+            TrackingRockets.RemoveAtSwap(i, 1, false);
+            continue;
+        }
+
+        // Our seeking rockets carry their own AdjustmentSpeed; stock ones had theirs parked at hand-off.
+        // A stock rocket with no hand-off entry still homes itself, so leave it alone.
+        AUTPlusProj_SeekingRocket* SeekingRocket = Cast<AUTPlusProj_SeekingRocket>(Rocket);
+        float AdjustmentSpeed = Rocket->AdjustmentSpeed;
+        if (SeekingRocket)
+        {
+            if (SeekingRocket->HasHomedThisFrame())
+            {
+                continue;
+            }
+        }
+        else
+        {
+            const FHandedOffRocket* HandOff = HandedOffRockets.FindByPredicate([Rocket](const FHandedOffRocket& Entry) { return Entry.Rocket.Get() == Rocket; });
+            if (HandOff == nullptr)
+            {
+                continue;
+            }
+            AdjustmentSpeed = HandOff->AdjustmentSpeed;
+        }
+
+        const FHomingTarget* HomingTarget = HomingTargets.FindByPredicate([Rocket](const FHomingTarget& Entry) { return Entry.Target == Rocket->TargetActor; });
+        if (HomingTarget == nullptr)
+        {
+            FHomingTarget NewEntry;
+            NewEntry.Target = Rocket->TargetActor;
+            NewEntry.Location = Rocket->TargetActor->GetActorLocation();
+            NewEntry.Velocity = Rocket->TargetActor->GetVelocity();
+            HomingTarget = &HomingTargets[HomingTargets.Add(NewEntry)];
+        }
+
+        FVector AimLocation = HomingTarget->Location;
+        if (SeekingLeadScale > 0.0f && Rocket->ProjectileMovement && Rocket->ProjectileMovement->MaxSpeed > 0.0f)
+        {
+            const float TimeToTarget = (AimLocation - Rocket->GetActorLocation()).Size() / Rocket->ProjectileMovement->MaxSpeed;
+            AimLocation += HomingTarget->Velocity * FMath::Min(TimeToTarget * SeekingLeadScale, SeekingMaxLeadTime);
+        }
+
+        if (SeekingRocket)
+        {
+            SeekingRocket->ApplyHoming(AimLocation, DeltaTime);
+        }
+        else
+        {
+            AUTPlusProj_SeekingRocket::SteerRocket(Rocket, AimLocation, AdjustmentSpeed, DeltaTime);
+        }
+
+        // Passed the target - nothing left to draw or steer
+        if (Rocket->TargetActor == nullptr)
+        {
+            ReleaseRocketHoming(Rocket);
+            TrackingRockets.RemoveAtSwap(i, 1, false);
+        }
+    }
+}
+
+void AUTPlusWeap_RocketLauncher::HandOffRocketHoming(AUTProj_Rocket* Rocket)
+{
+    if (Rocket == nullptr || HandedOffRockets.ContainsByPredicate([Rocket](const FHandedOffRocket& Entry) { return Entry.Rocket.Get() == Rocket; }))
+    {
+        return;
+    }
+
+    FHandedOffRocket HandOff;
+    HandOff.Rocket = Rocket;
+    HandOff.AdjustmentSpeed = Rocket->AdjustmentSpeed;
+    HandedOffRockets.Add(HandOff);
+    Rocket->AdjustmentSpeed = 0.0f;
+}
+
+void AUTPlusWeap_RocketLauncher::ReleaseRocketHoming(AUTProj_Rocket* Rocket)
+{
+    for (int32 i = HandedOffRockets.Num() - 1; i >= 0; i--)
+    {
+        AUTProj_Rocket* HandedOff = HandedOffRockets[i].Rocket.Get();
+        if (HandedOff == Rocket || HandedOff == nullptr)
+        {
+            if (HandedOff)
+            {
+                HandedOff->AdjustmentSpeed = HandedOffRockets[i].AdjustmentSpeed;
+            }
+            HandedOffRockets.RemoveAtSwap(i, 1, false);
+        }
+    }
+}
+
 void AUTPlusWeap_RocketLauncher::OnRep_LockedTarget()
 {
     SetLockTarget(LockedTarget);
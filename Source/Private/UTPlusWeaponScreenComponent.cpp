@@ -0,0 +1,59 @@
+// UTPlusWeaponScreenComponent.cpp
+
+#include "UTPlusWeaponScreenComponent.h"
+#include "Engine/CanvasRenderTarget2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Components/PrimitiveComponent.h"
+
+UUTPlusWeaponScreenComponent::UUTPlusWeaponScreenComponent(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    // Driven from the owning weapon's Tick, no tick of its own
+    PrimaryComponentTick.bCanEverTick = false;
+    VisibleRenderTime = 0.1f;
+    ScreenTexture = nullptr;
+    ScreenMesh = nullptr;
+    LastDisplayValue = 0;
+    bLastKillNotify = false;
+    LastColorState = 0;
+    bScreenDirty = true;
+}
+
+UCanvasRenderTarget2D* UUTPlusWeaponScreenComponent::CreateScreenTexture(UPrimitiveComponent* InMesh, UMaterialInstanceDynamic* ScreenMI, int32 Width, int32 Height)
+{
+    ScreenMesh = InMesh;
+    ScreenTexture = UCanvasRenderTarget2D::CreateCanvasRenderTarget2D(GetOwner(), UCanvasRenderTarget2D::StaticClass(), Width, Height);
+    if (ScreenTexture)
+    {
+        ScreenTexture->ClearColor = FLinearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        if (ScreenMI)
+        {
+            ScreenMI->SetTextureParameterValue(FName(TEXT("ScreenTexture")), ScreenTexture);
+        }
+    }
+    bScreenDirty = true;
+    return ScreenTexture;
+}
+
+void UUTPlusWeaponScreenComponent::UpdateScreen(int32 DisplayValue, bool bKillNotify, uint8 ColorState)
+{
+    if (DisplayValue != LastDisplayValue || bKillNotify != bLastKillNotify || ColorState != LastColorState)
+    {
+        LastDisplayValue = DisplayValue;
+        bLastKillNotify = bKillNotify;
+        LastColorState = ColorState;
+        bScreenDirty = true;
+    }
+
+    if (!bScreenDirty || ScreenTexture == nullptr || ScreenMesh == nullptr || !ScreenMesh->IsRegistered())
+    {
+        return;
+    }
+
+    // Same visibility test the weapons used to redraw every frame with
+    if (GetWorld()->TimeSeconds - ScreenMesh->LastRenderTime < VisibleRenderTime)
+    {
+        ScreenTexture->FastUpdateResource();
+        bScreenDirty = false;
+    }
+}
@@ -11,6 +11,9 @@
 #include "Animation/AnimInstance.h"
 #include "UTRewardMessage.h"
 #include "UTCharacter.h"
+#include "NetcodePlusStats.h"
+#include "NetcodePlusSessionRecorder.h"
+#include "NetcodePlusNetDiagnostics.h"
 
 
 
@@ -29,6 +32,35 @@ AUTWeap_LinkGun_Plus::AUTWeap_LinkGun_Plus(const FObjectInitializer& ObjectIniti
 	LastBeamActivityTime = 0.f;
 	//MaxHitDistanceTolerance = 300.0f; // Allow 3 meters of lag discrepancy
 	ClientDamageBatchSize = 15;
+	OverheatHeatRate = 0.42f;
+	OverheatDecayRate = 2.2f;
+	OverheatDecayDelay = 0.3f;
+	OverheatCooldownRate = 2.f;
+	OverheatAnchorSegment = ELinkOverheatSegment::Idle;
+	OverheatAnchorValue = 0.f;
+	OverheatAnchorTime = 0.f;
+	bOverheatAnchorHeating = false;
+	OverheatPitchBucket = -1;
+	ScreenComponent = ObjectInitializer.CreateDefaultSubobject<UUTPlusWeaponScreenComponent>(this, TEXT("ScreenComponent"));
+	BeamStreamTimeSlack = 0.3f;
+	BeamValidationCacheTime = 0.1f;
+	BeamValidationAngleTolerance = 2.f;
+	BeamValidationMoveTolerance = 16.f;
+	BeamStreamSessionId = 0;
+	BeamStreamSequence = 0;
+	bBeamStreamOpen = false;
+	BeamStreamDamage = 0.f;
+	BeamStreamSentDamage = 0;
+	BeamStreamLastHitLoc = FVector::ZeroVector;
+	ServerBeamSessionId = 0;
+	ServerBeamSequence = 0;
+	bServerBeamSessionOpen = false;
+	ServerBeamAppliedDamage = 0;
+	ServerBeamPrevSessionId = 0;
+	bServerBeamPrevSessionOpen = false;
+	ServerBeamPrevAppliedDamage = 0;
+	ServerBeamDamageBudget = 0.f;
+	ServerBeamBudgetTime = -1.f;
 	CurrentLinkedTarget = nullptr;
 	LinkStartTime = -100.f;
 	if (FiringState.Num() > 0)
@@ -99,7 +131,7 @@ void AUTWeap_LinkGun_Plus::FireShot()
 		// Note: We scope it to AUTWeapon (Grandparent) explicitly.
 		AUTWeapon::FireShot();
 	}
-	else if (!bIsInCoolDown)
+	else if (!IsOverheatCoolingDown())
 	{
 		// Mode 0 is Plasma (Projectile).
 		// Use the standard Fix logic (Transactional) for this.
@@ -129,138 +161,229 @@ void AUTWeap_LinkGun_Plus::ServerStopBeamFiring_Implementation()
 void AUTWeap_LinkGun_Plus::ProcessClientSideHit(float DeltaTime, AActor* HitActor, FVector HitLoc, const FInstantHitDamageInfo& DamageInfo)
 {
 	UUTWeaponStateFiringLinkBeamPlus* BeamState = Cast<UUTWeaponStateFiringLinkBeamPlus>(GetCurrentState());
-	if (!BeamState) return;
+	if (!BeamState || !HitActor) return;
+
+	// --- BEAM STREAM: new target = new session ---
+	if (!bBeamStreamOpen || BeamStreamTarget.Get() != HitActor)
+	{
+		EndBeamHitStream();
+		BeamStreamSessionId++;
+		BeamStreamSequence = 0;
+		BeamStreamDamage = 0.f;
+		BeamStreamSentDamage = 0;
+		BeamStreamTarget = HitActor;
+		bBeamStreamOpen = true;
+	}
 
 	float RefireTime = GetRefireTime(GetCurrentFireMode());
 	float DamagePerSec = float(DamageInfo.Damage) / RefireTime;
 
-	BeamState->ClientDamageAccumulator += DamagePerSec * DeltaTime;
+	BeamStreamDamage += DamagePerSec * DeltaTime;
+	BeamStreamLastHitLoc = HitLoc;
 
-	// Use the Configurable Batch Size
-	int32 PendingDamage = FMath::TruncToInt(BeamState->ClientDamageAccumulator);
+	// Use the Configurable Batch Size - but send the running total, not the batch,
+	// so dropping this packet loses nothing once the next one arrives
+	int32 TotalDamage = FMath::TruncToInt(BeamStreamDamage);
 
-	if (PendingDamage >= ClientDamageBatchSize)
+	if (TotalDamage - BeamStreamSentDamage >= ClientDamageBatchSize)
 	{
-		ServerProcessBeamHit(HitActor, HitLoc, PendingDamage);
-		BeamState->ClientDamageAccumulator -= PendingDamage;
+		ServerBeamHitStream(BeamStreamSessionId, ++BeamStreamSequence, HitActor, HitLoc, TotalDamage);
+		BeamStreamSentDamage = TotalDamage;
 	}
 }
 
+void AUTWeap_LinkGun_Plus::EndBeamHitStream()
+{
+	if (!bBeamStreamOpen)
+	{
+		return;
+	}
+	bBeamStreamOpen = false;
 
+	// One reliable per session: carries the exact final total, which also covers any
+	// unreliable updates that were lost and the sub-batch remainder
+	int32 TotalDamage = FMath::TruncToInt(BeamStreamDamage);
+	if (TotalDamage > 0 && BeamStreamTarget.IsValid())
+	{
+		ServerEndBeamHitStream(BeamStreamSessionId, BeamStreamTarget.Get(), BeamStreamLastHitLoc, TotalDamage);
+	}
+	BeamStreamTarget = nullptr;
+	BeamStreamDamage = 0.f;
+	BeamStreamSentDamage = 0;
+}
 
+bool AUTWeap_LinkGun_Plus::ServerBeamHitStream_Validate(uint8 SessionId, uint16 Sequence, AActor* HitActor, FVector_NetQuantize HitLocation, int32 CumulativeDamage)
+{
+	// Cap is enforced by clamping in HandleBeamHitStream, not by kicking
+	return CumulativeDamage >= 0;
+}
 
+void AUTWeap_LinkGun_Plus::ServerBeamHitStream_Implementation(uint8 SessionId, uint16 Sequence, AActor* HitActor, FVector_NetQuantize HitLocation, int32 CumulativeDamage)
+{
+	HandleBeamHitStream(SessionId, Sequence, HitActor, HitLocation, CumulativeDamage, false);
+}
 
+bool AUTWeap_LinkGun_Plus::ServerEndBeamHitStream_Validate(uint8 SessionId, AActor* HitActor, FVector_NetQuantize HitLocation, int32 FinalDamage)
+{
+	return FinalDamage >= 0;
+}
 
-/*
-bool AUTWeap_LinkGun_Plus::ServerProcessBeamHit_Validate(AActor* HitActor, FVector_NetQuantize HitLocation, int32 DamageAmount)
+void AUTWeap_LinkGun_Plus::ServerEndBeamHitStream_Implementation(uint8 SessionId, AActor* HitActor, FVector_NetQuantize HitLocation, int32 FinalDamage)
 {
-	if (!HitActor) return false;
+	// Reliable end is always the newest word on its session, so it bypasses the sequence check
+	HandleBeamHitStream(SessionId, MAX_uint16, HitActor, HitLocation, FinalDamage, true);
+}
 
-	// Base cap = BatchSize + one tick's worth of damage as buffer
-	// At 233 DPS and 120 tick: ~2 damage per tick max
-	// Add generous headroom for frame spikes
-	int32 DamageCap = ClientDamageBatchSize + 10;
+void AUTWeap_LinkGun_Plus::HandleBeamHitStream(uint8 SessionId, uint16 Sequence, AActor* HitActor, const FVector& HitLocation, int32 CumulativeDamage, bool bFinal)
+{
+	NETCODEPLUS_SCOPE(STAT_NetcodePlus_ServerBeamHit, ServerBeamHit);
 
-	if (UTOwner)
+	if (FNetcodePlusSessionRecorder::IsRecording())
 	{
-		float FireRateMult = UTOwner->GetFireRateMultiplier();
-		DamageCap = FMath::CeilToInt(DamageCap * FireRateMult);
+		FNetcodePlusSessionRecorder::RecordBeamRpc(this, HitActor, HitLocation, CumulativeDamage, SessionId, Sequence, bFinal ? NPSessionBeam_StreamEnd : NPSessionBeam_Stream);
 	}
-
-	if (DamageAmount > DamageCap)
+	if (FNetcodePlusNetDiagnostics::HasSubscribers())
 	{
-		return false;
+		FNetcodePlusNetDiagnostics::RecordBeamBatch(UTOwner);
 	}
 
-	return true;
-}
-*/
-
+	if (!UTOwner || !InstantHitInfo.IsValidIndex(1) || !FireInterval.IsValidIndex(1)) return;
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float BeamDPS = float(InstantHitInfo[1].Damage) / FMath::Max(FireInterval[1], 0.01f) * UTOwner->GetFireRateMultiplier();
 
-bool AUTWeap_LinkGun_Plus::ServerProcessBeamHit_Validate(
-	AActor* HitActor,
-	FVector_NetQuantize HitLocation,
-	int32 DamageAmount)
-{
-	// If the actor is gone, just ignore this batch.
+	// Which session's applied total does this update settle against?
+	int32* AppliedDamage = &ServerBeamAppliedDamage;
 
-	if (!HitActor)
+	// Session ids wrap; anything up to half the range ahead counts as newer
+	const uint8 SessionDelta = uint8(SessionId - ServerBeamSessionId);
+	if (SessionDelta == 0)
 	{
-
-		return true; // allow, but do nothing in _Implementation when HitActor is null
+		if (!bServerBeamSessionOpen || (!bFinal && Sequence <= ServerBeamSequence))
+		{
+			return; // closed session, or reordered/duplicate update
+		}
+		ServerBeamSequence = Sequence;
+		if (bFinal)
+		{
+			bServerBeamSessionOpen = false;
+		}
 	}
-
-	int32 DamageCap = 40;
-	if (UTOwner)
+	else if (SessionDelta < 128)
 	{
-		float FireRateMult = UTOwner->GetFireRateMultiplier();
-		DamageCap = FMath::CeilToInt(40 * FireRateMult);
+		// New session. The old one stays settleable until its End shows up; its damage is
+		// already paid for, so only the budget (not a fresh per-session allowance) limits the new one
+		if (bServerBeamSessionOpen)
+		{
+			ServerBeamPrevSessionId = ServerBeamSessionId;
+			ServerBeamPrevAppliedDamage = ServerBeamAppliedDamage;
+			bServerBeamPrevSessionOpen = true;
+		}
+		ServerBeamSessionId = SessionId;
+		ServerBeamSequence = bFinal ? 0 : Sequence;
+		ServerBeamAppliedDamage = 0;
+		bServerBeamSessionOpen = !bFinal;
 	}
-
-	if (DamageAmount > DamageCap)
+	else if (bFinal && bServerBeamPrevSessionOpen && SessionId == ServerBeamPrevSessionId)
+	{
+		// Reliable End of the previous session, overtaken by the next session's unreliable updates
+		AppliedDamage = &ServerBeamPrevAppliedDamage;
+		bServerBeamPrevSessionOpen = false;
+	}
+	else
 	{
+		return; // late packet from a session we already moved past
+	}
+	LastBeamActivityTime = Now;
 
-		// dont kick  just clamp in _Implementation
-		return true;
+	const int32 DeltaDamage = CumulativeDamage - *AppliedDamage;
+	if (DeltaDamage <= 0)
+	{
+		return;
 	}
+	// Rate cap: whatever the session bookkeeping says, the beam can't out-deal its DPS. Consume the
+	// granted part even if validation rejects it, so it isn't re-applied by a later update; anything
+	// over budget stays unapplied and can be claimed again by the session's next total.
+	const int32 GrantedDamage = ConsumeBeamDamageBudget(DeltaDamage, BeamDPS, Now);
+	*AppliedDamage += GrantedDamage;
 
-	return true;
+	if (HitActor && GrantedDamage > 0)
+	{
+		ApplyBeamDamage(HitActor, HitLocation, GrantedDamage);
+	}
 }
 
-
-
-void AUTWeap_LinkGun_Plus::ServerProcessBeamHit_Implementation(AActor* HitActor, FVector_NetQuantize HitLocation, int32 DamageAmount)
+float AUTWeap_LinkGun_Plus::GetBeamDamageBudgetCapacity(float BeamDPS) const
 {
-	if (!UTOwner || !InstantHitInfo.IsValidIndex(1)) return;
-	LastBeamActivityTime = GetWorld()->GetTimeSeconds();
+	return float(ClientDamageBatchSize) + BeamDPS * BeamStreamTimeSlack;
+}
 
-	if (!HitActor)
+int32 AUTWeap_LinkGun_Plus::ConsumeBeamDamageBudget(int32 Requested, float BeamDPS, float Now)
+{
+	const float Capacity = GetBeamDamageBudgetCapacity(BeamDPS);
+	if (ServerBeamBudgetTime < 0.f)
 	{
-		// actor already dead or gone, nothing to do
-		return;
+		ServerBeamDamageBudget = Capacity;
 	}
-
-	int32 DamageCap = 40;
-	if (UTOwner)
+	else
 	{
-		float FireRateMult = UTOwner->GetFireRateMultiplier();
-		DamageCap = FMath::CeilToInt(40 * FireRateMult);
+		ServerBeamDamageBudget = FMath::Min(ServerBeamDamageBudget + BeamDPS * FMath::Max(Now - ServerBeamBudgetTime, 0.f), Capacity);
 	}
+	ServerBeamBudgetTime = Now;
 
-	DamageAmount = FMath::Min(DamageAmount, DamageCap);
+	const int32 Granted = FMath::Clamp(Requested, 0, FMath::FloorToInt(ServerBeamDamageBudget));
+	ServerBeamDamageBudget -= Granted;
+	return Granted;
+}
 
+bool AUTWeap_LinkGun_Plus::ValidateBeamHit(AActor* HitActor, const FVector& FireStart, const FVector& HitLocation)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	const FVector BeamDir = (HitLocation - FireStart).GetSafeNormal();
+
+	// --- VALIDATION CACHE ---
+	// Same target this server frame: reuse whatever we decided (several batches/stream
+	// updates can land in one tick). A fresh *pass* is also reused on later frames while
+	// the beam hasn't moved; a fail is only reused within the frame it was computed.
+	if (BeamValidationCache.Target.Get() == HitActor)
+	{
+		if (BeamValidationCache.Frame == GFrameCounter)
+		{
+			return BeamValidationCache.bValid;
+		}
+		if (BeamValidationCache.bValid
+			&& Now - BeamValidationCache.Time <= BeamValidationCacheTime
+			&& (BeamDir | BeamValidationCache.BeamDir) >= FMath::Cos(FMath::DegreesToRadians(BeamValidationAngleTolerance))
+			&& FVector::DistSquared(FireStart, BeamValidationCache.FireStart) <= FMath::Square(BeamValidationMoveTolerance))
+		{
+			return true;
+		}
+	}
 
-	AUTPlayerState* PS = UTOwner->Controller ? Cast<AUTPlayerState>(UTOwner->Controller->PlayerState) : nullptr;
-	if (!PS) return;
+	BeamValidationCache.Target = HitActor;
+	BeamValidationCache.Frame = GFrameCounter;
+	BeamValidationCache.Time = Now;
+	BeamValidationCache.BeamDir = BeamDir;
+	BeamValidationCache.FireStart = FireStart;
+	BeamValidationCache.bValid = false;
 
 	// ---------------------------------------------------------
-	// STEP 1: GLOBAL SANITY CHECKS (Walls, Max Dist)
+	// STEP 1: WALL CHECK (prevents shooting through geometry)
 	// ---------------------------------------------------------
-	FVector FireStart = GetFireStartLoc();
-	float DistSq = FVector::DistSquared(FireStart, HitLocation);
-	float MaxDist = InstantHitInfo[1].TraceRange + MaxHitDistanceTolerance;
-
-	if (DistSq > FMath::Square(MaxDist)) return;
-
-	// Simple wall check (prevents shooting through geometry)
 	FHitResult WallHit;
 	FCollisionQueryParams Params(FName(TEXT("LinkValidation")), true, UTOwner);
 	if (GetWorld()->LineTraceSingleByChannel(WallHit, FireStart, HitLocation, COLLISION_TRACE_WEAPONNOCHARACTER, Params))
 	{
-		return;
+		return false;
 	}
 
 	// ---------------------------------------------------------
 	// STEP 2: ADAPTIVE VALIDATION
 	// ---------------------------------------------------------
+	AUTPlayerState* PS = UTOwner->Controller ? Cast<AUTPlayerState>(UTOwner->Controller->PlayerState) : nullptr;
+	float CurrentPing = PS ? PS->ExactPing : 0.f;
 
-	// Config: 80ms is a safe crossover point
-	//const float LowPingThreshold = 80.0f;
-	bool bHitValidated = false;
-	float CurrentPing = PS->ExactPing;
 	// HYSTERESIS LOGIC
 	// Define the buffer zone (e.g. +/- 5ms around your 80ms target)
-
 	if (CurrentPing > (LowPingThreshold + HysteresisBuffer))
 	{
 		bHighPingMode = true;
@@ -271,50 +394,47 @@ void AUTWeap_LinkGun_Plus::ServerProcessBeamHit_Implementation(AActor* HitActor,
 	}
 	// If between 75 and 85, keep previous state (bHighPingMode doesn't change)
 
-	// LOGIC SELECTION
 	if (!bHighPingMode)
 	{
 		// PATH A: LOW PING (Trust Client / CSHD)
-		bHitValidated = true;
+		BeamValidationCache.bValid = true;
 	}
 	else
 	{
 		// --- PATH B: HIGH PING (Lenient Rewind) ---
 		// The player is lagging. The server's rewind might be imperfect.
 		// We compensate by making the beam THICKER on the server side.
-
-		// 1. Calculate Rewind Time based on their ping
 		float PredictionTime = Super::GetHitValidationPredictionTime();
+		float LenientWidth = InstantHitInfo[1].TraceHalfSize + HighPingBeamWidthPadding;
 
-		// 2. Define Leniency
-		// Normal beam might be 0.0f or 12.0f. 
-		// For high ping, we bump it to 25.0f+ (Approx width of a character torso).
-		// This means if the rewind is "close enough", we grant the hit.
-		float BaseWidth = InstantHitInfo[1].TraceHalfSize;
-		float LenientWidth = BaseWidth + HighPingBeamWidthPadding;
-
-		// 3. Perform the Server-Side Rewind Trace with EXTRA WIDTH
 		FHitResult ServerHit;
-		FVector TraceEnd = FireStart + (HitLocation - FireStart).GetSafeNormal() * (InstantHitInfo[1].TraceRange);
+		FVector TraceEnd = FireStart + BeamDir * InstantHitInfo[1].TraceRange;
 
-		// We use HitScanTrace (from your WeaponFix) because it handles the rewind logic internally.
-		// We pass 'LenientWidth' instead of the default.
+		// We use HitScanTrace (from WeaponFix) because it handles the rewind logic internally.
 		HitScanTrace(FireStart, TraceEnd, LenientWidth, ServerHit, PredictionTime);
 
-		if (ServerHit.Actor.Get() == HitActor)
-		{
-			// Server confirms the hit (using the wider beam)
-			bHitValidated = true;
-		}
-		else
-		{
-			// Even with leniency, the server says you missed.
-			// This usually means the player is shooting at a "ghost" or lagging excessively.
-			bHitValidated = false;
-		}
+		// Even with leniency a miss usually means shooting at a "ghost" or lagging excessively
+		BeamValidationCache.bValid = (ServerHit.Actor.Get() == HitActor);
 	}
 
-	if (!bHitValidated) return;
+	return BeamValidationCache.bValid;
+}
+
+void AUTWeap_LinkGun_Plus::ApplyBeamDamage(AActor* HitActor, const FVector& HitLocation, int32 DamageAmount)
+{
+	if (!UTOwner || !HitActor || !InstantHitInfo.IsValidIndex(1)) return;
+
+	AUTPlayerState* PS = UTOwner->Controller ? Cast<AUTPlayerState>(UTOwner->Controller->PlayerState) : nullptr;
+	if (!PS) return;
+
+	// Max distance is cheap, so it isn't cached
+	FVector FireStart = GetFireStartLoc();
+	float DistSq = FVector::DistSquared(FireStart, HitLocation);
+	float MaxDist = InstantHitInfo[1].TraceRange + MaxHitDistanceTolerance;
+
+	if (DistSq > FMath::Square(MaxDist)) return;
+
+	if (!ValidateBeamHit(HitActor, FireStart, HitLocation)) return;
 
 	// ---------------------------------------------------------
 	// STEP 3: APPLY DAMAGE
@@ -352,10 +472,8 @@ void AUTWeap_LinkGun_Plus::AttachToOwner_Implementation()
 	if (!IsRunningDedicatedServer() && Mesh != NULL && ScreenMaterialID < Mesh->GetNumMaterials())
 	{
 		ScreenMI = Mesh->CreateAndSetMaterialInstanceDynamic(ScreenMaterialID);
-		ScreenTexture = UCanvasRenderTarget2D::CreateCanvasRenderTarget2D(this, UCanvasRenderTarget2D::StaticClass(), 64, 64);
-		ScreenTexture->ClearColor = FLinearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		ScreenTexture = ScreenComponent->CreateScreenTexture(Mesh, ScreenMI);
 		ScreenTexture->OnCanvasRenderTargetUpdate.AddDynamic(this, &AUTWeap_LinkGun_Plus::UpdateScreenTexture);
-		ScreenMI->SetTextureParameterValue(FName(TEXT("ScreenTexture")), ScreenTexture);
 
 		if (SideScreenMaterialID < Mesh->GetNumMaterials())
 		{
@@ -455,7 +573,7 @@ AUTProjectile* AUTWeap_LinkGun_Plus::FireProjectile()
 	AUTProj_LinkPlasma* LinkProj = Cast<AUTProj_LinkPlasma>(Super::FireProjectile());
 	if (LinkProj != NULL)
 	{
-		LastFiredPlasmaTime = GetWorld()->GetTimeSeconds();
+		LastFiredPlasmaTime = GetOverheatClock();
 	}
 
 	return LinkProj;
@@ -470,39 +588,154 @@ void AUTWeap_LinkGun_Plus::PlayWeaponAnim(UAnimMontage* WeaponAnim, UAnimMontage
 	}
 }
 
-bool AUTWeap_LinkGun_Plus::IsLinkPulsing()
+bool AUTWeap_LinkGun_Plus::ShouldOverheatHeat() const
 {
-	return (GetWorld()->GetTimeSeconds() - LastBeamPulseTime < BeamPulseInterval);
+	return UTOwner && IsFiring() && (CurrentFireMode == 0) && (UTOwner->GetFireRateMultiplier() <= 1.f);
 }
 
-void AUTWeap_LinkGun_Plus::Tick(float DeltaTime)
+float AUTWeap_LinkGun_Plus::EvaluateOverheat(float Now, ELinkOverheatSegment::Type& OutSegment) const
 {
-	Super::Tick(DeltaTime);
-
-	if (bIsInCoolDown)
+	ELinkOverheatSegment::Type Segment = OverheatAnchorSegment;
+	float Value = OverheatAnchorValue;
+	float SegmentStart = OverheatAnchorTime;
+	// The client's server-time estimate can step back slightly when its offset is re-measured
+	Now = FMath::Max(Now, SegmentStart);
+
+	// RefreshOverheat re-anchors at every boundary it sees, so this normally walks at most
+	// one boundary; the cap only guards against a weapon that hasn't ticked for a long time.
+	for (int32 Step = 0; Step < 8; Step++)
 	{
-		OverheatFactor -= 2.f * DeltaTime;
-		if (OverheatFactor <= 0.f)
+		if (Segment == ELinkOverheatSegment::Cooldown)
+		{
+			const float CooldownEnd = SegmentStart + Value / FMath::Max(OverheatCooldownRate, KINDA_SMALL_NUMBER);
+			if (Now < CooldownEnd)
+			{
+				OutSegment = Segment;
+				return Value - OverheatCooldownRate * (Now - SegmentStart);
+			}
+			// Cooldown over: resume heating if the trigger is still held, otherwise idle at 0
+			SegmentStart = CooldownEnd;
+			Value = 0.f;
+			Segment = bOverheatAnchorHeating ? ELinkOverheatSegment::Heating : ELinkOverheatSegment::Idle;
+		}
+		else if (Segment == ELinkOverheatSegment::Heating)
 		{
-			OverheatFactor = 0.f;
-			bIsInCoolDown = false;
-			if (UTOwner)
+			if (OverheatHeatRate <= 0.f)
+			{
+				OutSegment = Segment;
+				return Value;
+			}
+			const float OverheatTime = SegmentStart + (1.f - Value) / OverheatHeatRate;
+			if (Now < OverheatTime)
 			{
-				UTOwner->SetAmbientSound(OverheatSound, true);
+				OutSegment = Segment;
+				return Value + OverheatHeatRate * (Now - SegmentStart);
 			}
+			SegmentStart = OverheatTime;
+			Value = 1.f;
+			Segment = ELinkOverheatSegment::Cooldown;
+		}
+		else
+		{
+			// Idle decay only counts time past OverheatDecayDelay after the last plasma shot
+			const float DecayStart = FMath::Max(SegmentStart, LastFiredPlasmaTime + OverheatDecayDelay);
+			OutSegment = Segment;
+			return FMath::Max(0.f, Value - OverheatDecayRate * FMath::Max(0.f, Now - DecayStart));
+		}
+	}
+	OutSegment = Segment;
+	return Value;
+}
+
+float AUTWeap_LinkGun_Plus::GetOverheatClock() const
+{
+	// Same time base as the transactional fire timestamps (ServerStartFireFixed)
+	AGameStateBase* GS = GetWorld()->GetGameState();
+	return GS ? GS->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+float AUTWeap_LinkGun_Plus::GetOverheatFactor() const
+{
+	ELinkOverheatSegment::Type Segment;
+	return EvaluateOverheat(GetOverheatClock(), Segment);
+}
+
+bool AUTWeap_LinkGun_Plus::IsOverheatCoolingDown() const
+{
+	ELinkOverheatSegment::Type Segment;
+	EvaluateOverheat(GetOverheatClock(), Segment);
+	return Segment == ELinkOverheatSegment::Cooldown;
+}
+
+void AUTWeap_LinkGun_Plus::RefreshOverheat()
+{
+	const bool bHeating = ShouldOverheatHeat();
+
+	// Cold and not firing: nothing to evaluate
+	if (!bHeating && !bOverheatAnchorHeating && OverheatAnchorSegment == ELinkOverheatSegment::Idle && OverheatAnchorValue <= 0.f)
+	{
+		return;
+	}
+
+	const float Now = GetOverheatClock();
+	ELinkOverheatSegment::Type Segment;
+	const float Value = EvaluateOverheat(Now, Segment);
+
+	// Re-anchor on fire start/stop, on segment boundaries, and once idle decay reaches 0
+	// (which lets the early-out above take over)
+	const bool bFullyCooled = (Segment == ELinkOverheatSegment::Idle && Value <= 0.f);
+	if (bHeating != bOverheatAnchorHeating || Segment != OverheatAnchorSegment || bFullyCooled)
+	{
+		if (Segment != ELinkOverheatSegment::Cooldown)
+		{
+			Segment = bHeating ? ELinkOverheatSegment::Heating : ELinkOverheatSegment::Idle;
 		}
-		else if (UTOwner && OverheatSound && (!IsFiring() || !FireLoopingSound.IsValidIndex(CurrentFireMode) || !FireLoopingSound[CurrentFireMode]))
+		OverheatAnchorSegment = Segment;
+		OverheatAnchorValue = Value;
+		OverheatAnchorTime = Now;
+		bOverheatAnchorHeating = bHeating;
+	}
+
+	const bool bWasInCoolDown = bIsInCoolDown;
+	OverheatFactor = Value;
+	bIsInCoolDown = (Segment == ELinkOverheatSegment::Cooldown);
+
+	if (!UTOwner)
+	{
+		return;
+	}
+	if (bWasInCoolDown && !bIsInCoolDown)
+	{
+		UTOwner->SetAmbientSound(OverheatSound, true);
+		OverheatPitchBucket = -1;
+	}
+	else if (bIsInCoolDown && OverheatSound && (!IsFiring() || !FireLoopingSound.IsValidIndex(CurrentFireMode) || !FireLoopingSound[CurrentFireMode]))
+	{
+		// Pitch only changes audibly in steps, so don't push it to the audio component every frame
+		const int32 PitchBucket = FMath::FloorToInt(OverheatFactor * 32.f);
+		if (PitchBucket != OverheatPitchBucket)
 		{
+			OverheatPitchBucket = PitchBucket;
 			UTOwner->SetAmbientSound(OverheatSound, false);
 			UTOwner->ChangeAmbientSoundPitch(OverheatSound, 0.5f + OverheatFactor);
 		}
 	}
 	else
 	{
-		OverheatFactor = (UTOwner && IsFiring() && (CurrentFireMode == 0) && (UTOwner->GetFireRateMultiplier() <= 1.f)) ? OverheatFactor + 0.42f * DeltaTime : FMath::Max(0.f, OverheatFactor - 2.2f * FMath::Max(0.f, DeltaTime - FMath::Max(0.f, 0.3f + LastFiredPlasmaTime - GetWorld()->GetTimeSeconds())));
-		bIsInCoolDown = (OverheatFactor > 1.f);
-
+		OverheatPitchBucket = -1;
 	}
+}
+
+bool AUTWeap_LinkGun_Plus::IsLinkPulsing()
+{
+	return (GetWorld()->GetTimeSeconds() - LastBeamPulseTime < BeamPulseInterval);
+}
+
+void AUTWeap_LinkGun_Plus::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RefreshOverheat();
 
 	if (!IsLinkPulsing())
 	{
@@ -519,9 +752,15 @@ void AUTWeap_LinkGun_Plus::Tick(float DeltaTime)
 		}
 	}
 
-	if (ScreenTexture != NULL && Mesh->IsRegistered() && GetWorld()->TimeSeconds - Mesh->LastRenderTime < 0.1f)
+	// --- SCREEN: redraw only when what it shows changes ---
+	// Inputs mirror UpdateScreenTexture: overheat % (or -1 for the cooldown "***"),
+	// kill-notify window, and the green/yellow/red colour bucket.
+	if (ScreenTexture != NULL)
 	{
-		ScreenTexture->FastUpdateResource();
+		const bool bKillNotify = (GetWorld()->TimeSeconds - LastClientKillTime < 2.5f && ScreenKillNotifyTexture != NULL);
+		const int32 OverheatPct = bIsInCoolDown ? -1 : int32(100.f * FMath::Clamp(OverheatFactor, 0.1f, 1.f));
+		const uint8 ColorState = bIsInCoolDown ? 2 : ((OverheatFactor <= (IsFiring() ? 0.5f : 0.f)) ? 0 : 1);
+		ScreenComponent->UpdateScreen(OverheatPct, bKillNotify, ColorState);
 	}
 
 	if (UTOwner && (UTOwner->GetWeapon() == this) && MuzzleFlash.IsValidIndex(1) && MuzzleFlash[1] != NULL)
@@ -758,6 +997,9 @@ void AUTWeap_LinkGun_Plus::StateChanged()
 {
 	Super::StateChanged();
 
+	// Fire start/stop: anchor the overheat curve at the exact transition, not next Tick
+	RefreshOverheat();
+
 	// set AI timer for beam pulse
 	static FName NAME_CheckBotPulseFire(TEXT("CheckBotPulseFire"));
 	if (CurrentFireMode == 1 && Cast<UUTWeaponStateFiring>(CurrentState) != NULL && Cast<AUTBot>(UTOwner->Controller) != NULL)
@@ -848,18 +1090,21 @@ void AUTWeap_LinkGun_Plus::DrawWeaponCrosshair_Implementation(UUTHUDWidget* Weap
 {
 	Super::DrawWeaponCrosshair_Implementation(WeaponHudWidget, RenderDelta);
 
-	if ((OverheatFactor > 0.f) && WeaponHudWidget && WeaponHudWidget->UTHUDOwner)
+	// Evaluated at draw time from the overheat segments
+	const float CurrentOverheat = GetOverheatFactor();
+	const bool bCurrentlyCoolingDown = IsOverheatCoolingDown();
+	if ((CurrentOverheat > 0.f) && WeaponHudWidget && WeaponHudWidget->UTHUDOwner)
 	{
 		float Width = 150.f;
 		float Height = 21.f;
 		float WidthScale = 0.625f;
-		float HeightScale = bIsInCoolDown ? 1.f : 0.5f;
+		float HeightScale = bCurrentlyCoolingDown ? 1.f : 0.5f;
 		//	WeaponHudWidget->DrawTexture(WeaponHudWidget->UTHUDOwner->HUDAtlas, 0.f, 96.f, Scale*Width, Scale*Height, 127, 671, Width, Height, 0.7f, FLinearColor::White, FVector2D(0.5f, 0.5f));
-		float ChargePct = FMath::Clamp(OverheatFactor, 0.f, 1.f);
-		WeaponHudWidget->DrawTexture(WeaponHudWidget->UTHUDOwner->HUDAtlas, 0.f, 40.f, WidthScale * Width * ChargePct, HeightScale * Height, 127, 641, Width, Height, bIsInCoolDown ? OverheatFactor : 0.7f, REDHUDCOLOR, FVector2D(0.5f, 0.5f));
-		if (bIsInCoolDown)
+		float ChargePct = FMath::Clamp(CurrentOverheat, 0.f, 1.f);
+		WeaponHudWidget->DrawTexture(WeaponHudWidget->UTHUDOwner->HUDAtlas, 0.f, 40.f, WidthScale * Width * ChargePct, HeightScale * Height, 127, 641, Width, Height, bCurrentlyCoolingDown ? CurrentOverheat : 0.7f, REDHUDCOLOR, FVector2D(0.5f, 0.5f));
+		if (bCurrentlyCoolingDown)
 		{
-			WeaponHudWidget->DrawText(NSLOCTEXT("LinkGun", "Overheat", "OVERHEAT"), 0.f, 37.f, WeaponHudWidget->UTHUDOwner->TinyFont, 0.75f, FMath::Min(3.f * OverheatFactor, 1.f), FLinearColor::Yellow, ETextHorzPos::Center, ETextVertPos::Center);
+			WeaponHudWidget->DrawText(NSLOCTEXT("LinkGun", "Overheat", "OVERHEAT"), 0.f, 37.f, WeaponHudWidget->UTHUDOwner->TinyFont, 0.75f, FMath::Min(3.f * CurrentOverheat, 1.f), FLinearColor::Yellow, ETextHorzPos::Center, ETextVertPos::Center);
 		}
 		WeaponHudWidget->DrawTexture(WeaponHudWidget->UTHUDOwner->HUDAtlas, 0.f, 40.f, WidthScale * Width, HeightScale * Height, 127, 612, Width, Height, 1.f, FLinearColor::White, FVector2D(0.5f, 0.5f));
 	}
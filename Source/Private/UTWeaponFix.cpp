@@ -9,6 +9,16 @@
 #include "UTWeaponStateFiring_Transactional.h"
 #include "UTWeaponStateFiringChargedRocket_Transactional.h"
 #include "UTWeaponStateZooming.h"
+#include "TeamArenaPredictionPC.h"
+#include "TeamArenaCharacter.h"
+#include "TeamArenaCharacterMovement.h"
+#include "NetcodePlusStats.h"
+#include "NetcodePlusRpcStats.h"
+#include "NetcodePlusAuditLog.h"
+#include "NetcodePlusLagCompKernel.h"
+#include "NetcodePlusFireSequenceKernel.h"
+#include "NetcodePlusSessionRecorder.h"
+#include "NetcodePlusNetDiagnostics.h"
 
 
 DEFINE_LOG_CATEGORY_STATIC(LogUTWeaponFix, Log, All);
@@ -466,23 +476,12 @@ void AUTWeaponFix::StartFire(uint8 FireModeNum)
                 }
             }
 
-            float Delay = MaxReadyTime - CurrentTime;
-
-            // Schedule a retry if the delay is significant
-            if (Delay > 0.01f)
-            {
-                float WaitTime = Delay + 0.01f;
-                FTimerDelegate RetryDel;
-                RetryDel.BindUObject(this, &AUTWeaponFix::OnRetryTimer, FireModeNum);
-                GetWorldTimerManager().SetTimer(RetryFireHandle[FireModeNum], RetryDel, WaitTime, false);
-            }
-            else
-            {
-                // Poll next frame if delay is tiny (animation lag)
-                FTimerDelegate RetryDel;
-                RetryDel.BindUObject(this, &AUTWeaponFix::OnRetryTimer, FireModeNum);
-                GetWorldTimerManager().SetTimer(RetryFireHandle[FireModeNum], RetryDel, 0.01f, false);
-            }
+            // Smart wait until just after the cooldown ends, or poll next frame if the delay
+            // is tiny (animation lag)
+            const float WaitTime = NetcodePlusFireSequence::RetryDelay(MaxReadyTime, CurrentTime);
+            FTimerDelegate RetryDel;
+            RetryDel.BindUObject(this, &AUTWeaponFix::OnRetryTimer, FireModeNum);
+            GetWorldTimerManager().SetTimer(RetryFireHandle[FireModeNum], RetryDel, WaitTime, false);
         }
         return;
     }
@@ -644,16 +643,33 @@ void AUTWeaponFix::FireShot()
             const FVector FireDir = SpawnRotation.Vector();
             const FVector EndTrace = SpawnLocation + FireDir * InstantHitInfo[CurrentFireMode].TraceRange;
 
-            FHitResult PreHit;
             // Use 0.0f prediction time because we are aiming at what we see right now
-            HitScanTrace(SpawnLocation, EndTrace, InstantHitInfo[CurrentFireMode].TraceHalfSize, PreHit, 0.0f);
+            // (GetHitValidationPredictionTime is 0 on clients too, so FireInstantHit can reuse it)
+            ClientPreTrace.Hit = FHitResult();
+            HitScanTrace(SpawnLocation, EndTrace, InstantHitInfo[CurrentFireMode].TraceHalfSize, ClientPreTrace.Hit, 0.0f);
+            ClientPreTrace.SpawnLocation = SpawnLocation;
+            ClientPreTrace.SpawnRotation = SpawnRotation;
+            ClientPreTrace.FireMode = CurrentFireMode;
+            ClientPreTrace.bValid = true;
+
+            ClientHitChar = Cast<AUTCharacter>(ClientPreTrace.Hit.Actor.Get());
+        }
 
-            ClientHitChar = Cast<AUTCharacter>(PreHit.Actor.Get());
+        // Held (coalesced) moves go out before the shot so the server fires from the right spot
+        UTeamArenaCharacterMovement* TeamMovement = UTOwner ? Cast<UTeamArenaCharacterMovement>(UTOwner->GetCharacterMovement()) : nullptr;
+        if (TeamMovement)
+        {
+            TeamMovement->NotifyFireBoundary();
         }
         ServerStartFireFixed(CurrentFireMode, NextEventIndex, GetWorld()->GetGameState()->GetServerWorldTimeSeconds(), false, ClientRot, ClientHitChar, ZOffset);
+        if (FNetcodePlusNetDiagnostics::IsOverlayActive())
+        {
+            FNetcodePlusNetDiagnostics::RecordShotSent(UTOwner);
+        }
 
-        // 4. Play Visuals
+        // 4. Play Visuals (FireInstantHit picks up ClientPreTrace instead of tracing again)
         Super::FireShot();
+        ClientPreTrace.bValid = false;
     }
     else
     // --- SERVER SIDE ---
@@ -831,6 +847,11 @@ void AUTWeaponFix::StopFire(uint8 FireModeNum)
         int32 EventIndex = ClientFireEventIndex.IsValidIndex(FireModeNum) ?
             ClientFireEventIndex[FireModeNum] : 0;
         float CurrentTime = GetWorld()->GetTimeSeconds();
+        UTeamArenaCharacterMovement* TeamMovement = Cast<UTeamArenaCharacterMovement>(UTOwner->GetCharacterMovement());
+        if (TeamMovement)
+        {
+            TeamMovement->NotifyFireBoundary();
+        }
         ServerStopFireFixed(FireModeNum, EventIndex, CurrentTime);
     }
     
@@ -856,12 +877,11 @@ bool AUTWeaponFix::ValidateFireRequest(uint8 FireModeNum, int32 InEventIndex, fl
 
     // Validate timing with network tolerance
     float ServerTime = GetWorld()->GetTimeSeconds();
-    float TimeDiff = FMath::Abs(ServerTime - ClientTime);
 
     // Allow reasonable network delay but reject obviously wrong timestamps
-    if (TimeDiff > 1.0f) // 1 second tolerance should be more than enough
+    if (NetcodePlusFireSequence::IsTimestampDesynced(ServerTime, ClientTime)) // 1 second tolerance should be more than enough
     {
-        UE_LOG(LogTemp, Warning, TEXT("WeaponFix: Rejected fire due to time desync: %f"), TimeDiff);
+        UE_LOG(LogTemp, Warning, TEXT("WeaponFix: Rejected fire due to time desync: %f"), FMath::Abs(ServerTime - ClientTime));
         return false;
     }
 
@@ -881,20 +901,13 @@ bool AUTWeaponFix::ValidateFireRequest(uint8 FireModeNum, int32 InEventIndex, fl
     */
     for (int32 i = 0; i < LastFireTime.Num(); i++)
     {
-        if (LastFireTime[i] > 0.0f)
+        // Get the refire time for mode [i] (the one that was fired previously)
+        // Subtract 60ms (ServerRefireTolerance) for network tolerance
+        if (NetcodePlusFireSequence::IsModeRecovering(LastFireTime[i], GetRefireTime(i), ServerTime, NetcodePlusFireSequence::ServerRefireTolerance))
         {
-            float TimeSinceLastFire = ServerTime - LastFireTime[i];
-
-            // Get the refire time for mode [i] (the one that was fired previously)
-            // Subtract 60ms (0.06f) for network tolerance
-            float MinInterval = GetRefireTime(i) - 0.06f;
-
-            if (TimeSinceLastFire < MinInterval)
-            {
-                UE_LOG(LogUTWeaponFix, Warning, TEXT("[Server] REJECTED Rapid Fire. Mode %d blocked by Mode %d recovery. Delta: %.3f < Min: %.3f"),
-                    FireModeNum, i, TimeSinceLastFire, MinInterval);
-                return false;
-            }
+            UE_LOG(LogUTWeaponFix, Warning, TEXT("[Server] REJECTED Rapid Fire. Mode %d blocked by Mode %d recovery. Delta: %.3f < Min: %.3f"),
+                FireModeNum, i, ServerTime - LastFireTime[i], GetRefireTime(i) - NetcodePlusFireSequence::ServerRefireTolerance);
+            return false;
         }
     }
 
@@ -930,17 +943,11 @@ bool AUTWeaponFix::IsFireModeOnCooldown(uint8 FireModeNum, float CurrentTime)
     // it cannot fire again.
     for (int32 i = 0; i < LastFireTime.Num(); i++)
     {
-        if (LastFireTime[i] > 0.0f)
+        // Client Tolerance (50ms)
+        // If we are within the refire window of ANY mode, block the shot.
+        if (NetcodePlusFireSequence::IsModeRecovering(LastFireTime[i], GetRefireTime(i), CurrentTime, NetcodePlusFireSequence::ClientRefireTolerance))
         {
-            float TimeSinceLastFire = CurrentTime - LastFireTime[i];
-            float RequiredInterval = GetRefireTime(i); // Get refire time for the mode that WAS fired
-
-            // Client Tolerance (50ms)
-            // If we are within the refire window of ANY mode, block the shot.
-            if (TimeSinceLastFire < (RequiredInterval - 0.05f))
-            {
-                return true;
-            }
+            return true;
         }
     }
 
@@ -970,19 +977,35 @@ bool AUTWeaponFix::IsFireEventSequenceValid(uint8 FireModeNum, int32 InEventInde
     }
 
     // Event must be newer than last processed, but not too far ahead
-    int32 LastProcessed = AuthoritativeFireEventIndex[FireModeNum];
-    return (InEventIndex > LastProcessed) && (InEventIndex <= LastProcessed + 10);
+    return NetcodePlusFireSequence::IsEventIndexValid(AuthoritativeFireEventIndex[FireModeNum], InEventIndex);
 }
 
 
 
+bool AUTWeaponFix::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+    FNetcodePlusRpcStats::FScope RpcStatsScope(this, Function);
+    return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void AUTWeaponFix::ServerStartFireFixed_Implementation(uint8 FireModeNum, int32 InFireEventIndex, float ClientTimestamp, bool bClientPredicted, FRotator ClientViewRot, AUTCharacter* ClientHitChar, uint8 ZOffset)
 {
+    NETCODEPLUS_SCOPE(STAT_NetcodePlus_ServerStartFire, ServerStartFire);
+
     // 1. VALIDATION (Your existing transactional checks)
     UWorld* World = GetWorld();
     if (!World) return;
 
-    if (!ValidateFireRequest(FireModeNum, InFireEventIndex, ClientTimestamp))
+    const bool bValidRequest = ValidateFireRequest(FireModeNum, InFireEventIndex, ClientTimestamp);
+    if (FNetcodePlusSessionRecorder::IsRecording())
+    {
+        FNetcodePlusSessionRecorder::RecordFireRpc(this, FireModeNum, InFireEventIndex, ClientTimestamp, bClientPredicted, ClientViewRot, ClientHitChar, ZOffset, bValidRequest);
+    }
+    if (FNetcodePlusNetDiagnostics::HasSubscribers())
+    {
+        FNetcodePlusNetDiagnostics::RecordShot(UTOwner, bValidRequest, GetHitValidationPredictionTime());
+    }
+    if (!bValidRequest)
     {
         ClientConfirmFireEvent(FireModeNum, AuthoritativeFireEventIndex.IsValidIndex(FireModeNum) ? AuthoritativeFireEventIndex[FireModeNum] : 0);
         return;
@@ -1022,34 +1045,12 @@ void AUTWeaponFix::ServerStartFireFixed_Implementation(uint8 FireModeNum, int32
 
     if (LastFireTime.IsValidIndex(FireModeNum))
     {
-        float CurrentTime = GetWorld()->GetTimeSeconds();
-        float Refire = GetRefireTime(FireModeNum);
-
-        // If LastFireTime is 0, this is the first shot.
-        if (LastFireTime[FireModeNum] <= 0.0f)
-        {
-            LastFireTime[FireModeNum] = CurrentTime;
-        }
-        else
-        {
-            // RHYTHM COMPENSATION:
-            // Calculate when the shot SHOULD have happened
-            float TheoreticalFireTime = LastFireTime[FireModeNum] + Refire;
-
-            // If the packet arrived roughly on time (within 200ms of expected window),
-            // we snap to the Theoretical Time. This absorbs the jitter.
-            // If it arrived WAY late (player stopped firing), we reset to CurrentTime.
-            if (CurrentTime < TheoreticalFireTime + 0.20f)
-            {
-                // Assume they fired perfectly on cooldown
-                LastFireTime[FireModeNum] = TheoreticalFireTime;
-            }
-            else
-            {
-                // They stopped firing for a while, reset to now.
-                LastFireTime[FireModeNum] = CurrentTime;
-            }
-        }
+        // RHYTHM COMPENSATION:
+        // If LastFireTime is 0, this is the first shot and we take now. Otherwise, if the packet
+        // arrived roughly on time (within 200ms of expected window), we snap to the Theoretical
+        // Time (Last + Refire), which absorbs the jitter. If it arrived WAY late (player stopped
+        // firing), we reset to now.
+        LastFireTime[FireModeNum] = NetcodePlusFireSequence::CompensatedFireTime(LastFireTime[FireModeNum], GetRefireTime(FireModeNum), GetWorld()->GetTimeSeconds());
     }
 
     if (FireModeActiveState.IsValidIndex(FireModeNum))
@@ -1288,7 +1289,12 @@ float AUTWeaponFix::GetHitValidationPredictionTime() const
 
     const float RTTms = PS->ExactPing;
 
-    float IdealMs = (RTTms / 2.0f) + SmoothingMs;
+    // Shooter draws proxies from a snapshot buffer: rewind by the exact delay it reported
+    // instead of the SmoothCorrection fudge
+    ATeamArenaPredictionPC* TeamPC = Cast<ATeamArenaPredictionPC>(UTOwner->GetController());
+    const float ProxyDelayMs = (TeamPC && TeamPC->GetProxyInterpDelay() > 0.0f) ? TeamPC->GetProxyInterpDelay() * 1000.0f : SmoothingMs;
+
+    float IdealMs = (RTTms / 2.0f) + ProxyDelayMs;
     float RewindMs = FMath::Clamp(IdealMs, 0.0f, MaxRewindMs);
 
     return RewindMs * 0.001f;
@@ -1298,6 +1304,8 @@ float AUTWeaponFix::GetHitValidationPredictionTime() const
 
 void AUTWeaponFix::HitScanTrace(const FVector& StartLocation, const FVector& EndTrace, float TraceRadius, FHitResult& Hit, float PredictionTime)
 {
+    NETCODEPLUS_SCOPE(STAT_NetcodePlus_HitScanTrace, HitScanTrace);
+
     // Override the prediction time parameter with hit validation time
     // This ensures we use split prediction's hit validation time (120ms)
     // instead of visual time (0ms) for server-side hit validation
@@ -1327,8 +1335,14 @@ void AUTWeaponFix::HitScanTrace(const FVector& StartLocation, const FVector& End
         Hit.Location = EndTrace;
     }
 
+    // Rewound projectiles (shock balls) go in before the pawns so a pawn behind a hit ball isn't picked
+    if (Role == ROLE_Authority && ActualPredictionTime > 0.f)
+    {
+        TraceRewoundProjectiles(StartLocation, EndTrace, TraceRadius, Hit, ActualPredictionTime);
+    }
 
     // Now check against pawns
+    const FVector PawnTraceEnd = Hit.Location;
     AUTCharacter* BestTarget = NULL;
     FVector BestPoint(0.f);
     FVector BestCapsulePoint(0.f);
@@ -1344,54 +1358,24 @@ void AUTWeaponFix::HitScanTrace(const FVector& StartLocation, const FVector& End
             if (bTeammatesBlockHitscan || !GS || !GS->OnSameTeam(UTOwner, Target))
             {
                 
-                float ExtraHitPadding = 0.f;
-
                 // Only apply padding if the client explicitly claimed THIS target.
-                // If client missed (ReceivedHitScanHitChar is null), this block is skipped (Padding = 0).
-                if (Target == ReceivedHitScanHitChar)
-                {
-                    // Check velocity to decide WHICH padding to use
-                    bool bIsMoving = !Target->GetVelocity().IsNearlyZero(1.0f);
+                // If client missed (ReceivedHitScanHitChar is null), Padding = 0.
+                // Velocity decides WHICH padding to use.
+                NetcodePlusLagComp::FCapsuleQuery Capsule;
+                Capsule.ExtraPadding = NetcodePlusLagComp::ClaimedTargetPadding(Target == ReceivedHitScanHitChar, Target->GetVelocity(), HitScanPadding, HitScanPaddingStationary);
 
-                    ExtraHitPadding = bIsMoving ? HitScanPadding : HitScanPaddingStationary;
-                }
                 // find appropriate rewind position, and test against trace from StartLocation to Hit.Location
                 FVector TargetLocation = ((ActualPredictionTime > 0.f) && (Role == ROLE_Authority)) ? Target->GetRewindLocation(ActualPredictionTime) : Target->GetActorLocation();
-                if (Role == ROLE_Authority && ActualPredictionTime > 0.f)
-                {
-                    float RTTms = UTOwner && UTOwner->PlayerState ? Cast<APlayerState>(UTOwner->PlayerState)->ExactPing : 0.f;
-                    float RewindDistance = (Target->GetActorLocation() - TargetLocation).Size();
+                // now see if trace would hit the capsule (sliding targets are tested low and short)
+                Capsule.HalfHeight = Target->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+                Capsule.Radius = Target->GetCapsuleComponent()->GetScaledCapsuleRadius();
+                Capsule.bSliding = Target->UTCharacterMovement && Target->UTCharacterMovement->bIsFloorSliding;
+                Capsule.SlideTargetHeight = Target->SlideTargetHeight;
+                const float CollisionRadius = Capsule.Radius;
 
-      
-                }
-                // now see if trace would hit the capsule
-                float CollisionHeight = Target->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
-                if (Target->UTCharacterMovement && Target->UTCharacterMovement->bIsFloorSliding)
-                {
-                    TargetLocation.Z = TargetLocation.Z - CollisionHeight + Target->SlideTargetHeight;
-                    CollisionHeight = Target->SlideTargetHeight;
-                }
-                float CollisionRadius = Target->GetCapsuleComponent()->GetScaledCapsuleRadius();
-
-                bool bCheckOutsideHit = false;
-                bool bHitTarget = false;
                 FVector ClosestPoint(0.f);
-                FVector ClosestCapsulePoint = TargetLocation;
-                if (CollisionRadius >= CollisionHeight)
-                {
-                    ClosestPoint = FMath::ClosestPointOnSegment(TargetLocation, StartLocation, Hit.Location);
-                    bHitTarget = ((ClosestPoint - TargetLocation).SizeSquared() < FMath::Square(CollisionHeight + TraceRadius + ExtraHitPadding));
-                    if (!bHitTarget && (ExtraHitPadding > 0.f))
-                    {
-                        bCheckOutsideHit = true;
-                    }
-                }
-                else
-                {
-                    FVector CapsuleSegment = FVector(0.f, 0.f, CollisionHeight - CollisionRadius);
-                    FMath::SegmentDistToSegmentSafe(StartLocation, Hit.Location, TargetLocation - CapsuleSegment, TargetLocation + CapsuleSegment, ClosestPoint, ClosestCapsulePoint);
-                    bHitTarget = ((ClosestPoint - ClosestCapsulePoint).SizeSquared() < FMath::Square(CollisionRadius + TraceRadius + ExtraHitPadding));
-                }
+                FVector ClosestCapsulePoint(0.f);
+                const bool bHitTarget = NetcodePlusLagComp::TraceHitsCapsule(StartLocation, Hit.Location, TraceRadius, TargetLocation, Capsule, ClosestPoint, ClosestCapsulePoint);
 
                 // If we hit, update best target
                 if (bHitTarget && (!BestTarget || ((ClosestPoint - StartLocation).SizeSquared() < (BestPoint - StartLocation).SizeSquared())))
@@ -1425,6 +1409,25 @@ void AUTWeaponFix::HitScanTrace(const FVector& StartLocation, const FVector& End
 
     if (Role == ROLE_Authority)
     {
+        // Shooter and target (hit or claimed) are in a fight - both replicate to each other at full rate
+        ATeamArenaCharacter* EngagedChar = Cast<ATeamArenaCharacter>(BestTarget ? BestTarget : ReceivedHitScanHitChar);
+        if (EngagedChar && UTOwner)
+        {
+            EngagedChar->NotifyHitScanEngagement(Cast<APlayerController>(UTOwner->GetController()));
+            ATeamArenaCharacter* Shooter = Cast<ATeamArenaCharacter>(UTOwner);
+            if (Shooter)
+            {
+                Shooter->NotifyHitScanEngagement(Cast<APlayerController>(EngagedChar->GetController()));
+            }
+        }
+
+        if (FNetcodePlusSessionRecorder::IsRecording())
+        {
+            const uint8 SkipTeam = (!bTeammatesBlockHitscan && GS && GS->bTeamGame && UTOwner) ? UTOwner->GetTeamNum() : 255;
+            FNetcodePlusSessionRecorder::RecordHitScan(this, ReceivedHitScanHitChar, BestTarget, StartLocation, PawnTraceEnd,
+                TraceRadius, ActualPredictionTime, HitScanPadding, HitScanPaddingStationary, SkipTeam);
+        }
+
         OnServerHitScanResult(Hit, ActualPredictionTime);
     }
 }
@@ -1748,92 +1751,32 @@ void AUTWeaponFix::FireInstantHit(bool bDealDamage, FHitResult* OutHit)
     checkSlow(InstantHitInfo.IsValidIndex(CurrentFireMode));
 
     // 1. Calculate aim ONCE - these values will be used for the entire function
-    const FVector SpawnLocation = GetFireStartLoc();
-    const FRotator SpawnRotation = GetAdjustedAim(SpawnLocation);
+    //    (owning client: FireShot already did, along with the trace it sent as the claim)
+    FVector SpawnLocation;
+    FRotator SpawnRotation;
+    FHitResult Hit;
+    const bool bPreTraced = ConsumeClientPreTrace(SpawnLocation, SpawnRotation, Hit);
+    if (!bPreTraced)
+    {
+        SpawnLocation = GetFireStartLoc();
+        SpawnRotation = GetAdjustedAim(SpawnLocation);
+    }
     const FVector FireDir = SpawnRotation.Vector();
     const FVector EndTrace = SpawnLocation + FireDir * InstantHitInfo[CurrentFireMode].TraceRange;
 
-    // DEBUG: Log what we calculated
-
-
     // 2. Do the hit trace
-    FHitResult Hit;
     AUTPlayerController* UTPC = UTOwner ? Cast<AUTPlayerController>(UTOwner->Controller) : nullptr;
     AUTPlayerState* PS = (UTOwner && UTOwner->Controller) ? Cast<AUTPlayerState>(UTOwner->Controller->PlayerState) : nullptr;
     float PredictionTime = GetHitValidationPredictionTime();
-    HitScanTrace(SpawnLocation, EndTrace, InstantHitInfo[CurrentFireMode].TraceHalfSize, Hit, PredictionTime);
-
-
-
-    // --------------------------------------------------------------------------
-// START DEBUG LOGGING
-// --------------------------------------------------------------------------
-    if (Role == ROLE_Authority)
+    if (!bPreTraced)
     {
-        // Case 1: Client claimed a hit, but Server disagrees
-        if (ReceivedHitScanHitChar != nullptr && Hit.Actor != ReceivedHitScanHitChar)
-        {
-            // Calculate how close the shot actually came on the Server
-            float ClosestDist = 9999.f;
-            FVector ClosestPointOnRay, ClosestPointOnCapsule;
-
-            // Rewind the claimed target to where the Server thinks it was
-            FVector RewoundLoc = ReceivedHitScanHitChar->GetRewindLocation(PredictionTime);
-            float CapRadius = ReceivedHitScanHitChar->GetCapsuleComponent()->GetScaledCapsuleRadius();
-            float CapHeight = ReceivedHitScanHitChar->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
-
-            // Math: Distance between the Shot Ray and the Rewound Capsule Segment
-            FVector CapsuleSegTop = RewoundLoc + FVector(0, 0, CapHeight - CapRadius);
-            FVector CapsuleSegBot = RewoundLoc - FVector(0, 0, CapHeight - CapRadius);
-
-            FMath::SegmentDistToSegmentSafe(
-                SpawnLocation, EndTrace,
-                CapsuleSegBot, CapsuleSegTop,
-                ClosestPointOnRay, ClosestPointOnCapsule
-            );
-
-            ClosestDist = FVector::Dist(ClosestPointOnRay, ClosestPointOnCapsule);
-            float MissMargin = ClosestDist - CapRadius; // How far off the "skin" of the capsule
-            /*
-            UE_LOG(LogUTWeaponFix, Warning, TEXT("[DEBUG] HIT REJECTED! Client Claimed: %s | Server Hit: %s | RewindTime: %.3fms | Missed Capsule By: %.2f units"),
-                *ReceivedHitScanHitChar->GetName(),
-                Hit.Actor.Get() ? *Hit.Actor->GetName() : TEXT("None"),
-                PredictionTime * 1000.f,
-                MissMargin); 
-			*/
-        }
-
-        // Case 2: Ghost Miss (Both missed, but maybe it was close?)
-        // Useful for checking if your Rewind Math is aligning the hitbox correctly
-        else if (ReceivedHitScanHitChar == nullptr && Hit.Actor == nullptr)
-        {
-            // Scan for nearest player to see how close we were
-            float BestDist = 9999.f;
-            AUTCharacter* NearestChar = nullptr;
-
-            for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
-            {
-                AUTCharacter* TestChar = Cast<AUTCharacter>(*It);
-                if (TestChar && TestChar != UTOwner && !TestChar->IsDead())
-                {
-                    FVector TestRewind = TestChar->GetRewindLocation(PredictionTime);
-                    // Simple point-to-line check for debug speed
-                    float Dist = FMath::PointDistToLine(TestRewind, EndTrace - SpawnLocation, SpawnLocation);
-                    if (Dist < BestDist) { BestDist = Dist; NearestChar = TestChar; }
-                }
-            }
-
-            if (NearestChar && BestDist < 80.0f) // Only log if reasonably close (e.g. < 80 units)
-            {
-                //UE_LOG(LogUTWeaponFix, Log, TEXT("[DEBUG] NEAR MISS. Nearest: %s | Dist: %.2f | RewindTime: %.3fms"),
-                //    *NearestChar->GetName(), BestDist, PredictionTime * 1000.f);
-            }
-        }
+        HitScanTrace(SpawnLocation, EndTrace, InstantHitInfo[CurrentFireMode].TraceHalfSize, Hit, PredictionTime);
     }
 
-
+    // Rejected-claim / near-miss diagnostics live in RecordHitAudit (np.HitDiag), not on every shot
 
     // 3. Check for headshot (using the SAME SpawnLocation and FireDir)
+    bool bHeadSphereHit = false;
     if (UTPC && bCheckHeadSphere && (Cast<AUTCharacter>(Hit.Actor.Get()) == nullptr) &&
         ((Spread.Num() <= GetCurrentFireMode()) || (Spread[GetCurrentFireMode()] == 0.f)) &&
         (UTOwner->GetVelocity().IsNearlyZero() || bCheckMovingHeadSphere))
@@ -1847,12 +1790,15 @@ void AUTWeaponFix::FireInstantHit(bool bDealDamage, FHitResult* OutHit)
             Hit = FHitResult(AltTarget, AltTarget->GetCapsuleComponent(),
                 SpawnLocation + FireDir * ((AltTarget->GetHeadLocation() - SpawnLocation).Size() -
                     AltTarget->GetCapsuleComponent()->GetUnscaledCapsuleRadius()), -FireDir);
+            bHeadSphereHit = true;
         }
     }
 
     // 4. Server-side processing
     if (Role == ROLE_Authority)
     {
+        RecordHitAudit(Hit, SpawnLocation, EndTrace, PredictionTime, bHeadSphereHit);
+
         if (PS && (ShotsStatsName != NAME_None))
         {
             PS->ModifyStatsValue(ShotsStatsName, 1);
@@ -1945,6 +1891,159 @@ void AUTWeaponFix::FireInstantHit(bool bDealDamage, FHitResult* OutHit)
 }
 
 
+bool AUTWeaponFix::ConsumeClientPreTrace(FVector& OutSpawnLocation, FRotator& OutSpawnRotation, FHitResult& OutHit)
+{
+    // One shot only: a second FireInstantHit in the same FireShot (or a beam state calling it
+    // directly) traces for itself
+    if (!ClientPreTrace.bValid || ClientPreTrace.FireMode != CurrentFireMode || Role == ROLE_Authority)
+    {
+        return false;
+    }
+    ClientPreTrace.bValid = false;
+    OutSpawnLocation = ClientPreTrace.SpawnLocation;
+    OutSpawnRotation = ClientPreTrace.SpawnRotation;
+    OutHit = ClientPreTrace.Hit;
+    return true;
+}
+
+float AUTWeaponFix::GetRewoundMissMargin(AUTCharacter* Target, const FVector& StartLocation, const FVector& EndTrace, float PredictionTime) const
+{
+    // Rewind the target to where the Server thinks it was
+    const FVector RewoundLoc = Target->GetRewindLocation(PredictionTime);
+    const float CapRadius = Target->GetCapsuleComponent()->GetScaledCapsuleRadius();
+    const float CapHeight = Target->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+    // Math: Distance between the Shot Ray and the Rewound Capsule Segment
+    const FVector CapsuleSegTop = RewoundLoc + FVector(0, 0, CapHeight - CapRadius);
+    const FVector CapsuleSegBot = RewoundLoc - FVector(0, 0, CapHeight - CapRadius);
+
+    FVector ClosestPointOnRay, ClosestPointOnCapsule;
+    FMath::SegmentDistToSegmentSafe(
+        StartLocation, EndTrace,
+        CapsuleSegBot, CapsuleSegTop,
+        ClosestPointOnRay, ClosestPointOnCapsule
+    );
+
+    return FVector::Dist(ClosestPointOnRay, ClosestPointOnCapsule) - CapRadius; // How far off the "skin" of the capsule
+}
+
+#if NETCODEPLUS_DIAGNOSTICS
+void AUTWeaponFix::AddHitDiagnostics(AUTCharacter* DiagChar, const FVector& StartLocation, const FVector& EndTrace, float PredictionTime, int32 DiagLevel, FNPAuditShot& Shot) const
+{
+    // Unclaimed misses pay an O(pawns) rewind scan, which is why none of this runs unless asked for
+    Shot.Flags |= NPAuditFlag_Diagnostics;
+    Shot.RewindDistance = DiagChar ? (DiagChar->GetActorLocation() - DiagChar->GetRewindLocation(PredictionTime)).Size() : 0.f;
+    Shot.NearMissMargin = NPAUDIT_NO_MARGIN;
+    Shot.NearMissTargetId = NPAUDIT_NO_ID;
+
+    if (Shot.Result == NPAuditShot_Rejected)
+    {
+        if (DiagLevel >= 2)
+        {
+            UE_LOG(LogUTWeaponFix, Warning, TEXT("[HitDiag] HIT REJECTED! Client Claimed: %d | Server Hit: %d | RewindTime: %.3fms | RewindDist: %.1f | Missed Capsule By: %.2f units"),
+                Shot.ClaimedTargetId, Shot.ServerHitId, Shot.RewindMs, Shot.RewindDistance, Shot.MissMargin);
+        }
+        return;
+    }
+    if (Shot.Result != NPAuditShot_Miss)
+    {
+        return;
+    }
+
+    // Ghost miss: both sides missed, how close did the rewound hitboxes come?
+    AUTCharacter* NearestChar = nullptr;
+    float BestMargin = MAX_FLT;
+    for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
+    {
+        AUTCharacter* TestChar = Cast<AUTCharacter>(*It);
+        if (TestChar && TestChar != UTOwner && !TestChar->IsDead())
+        {
+            const float Margin = GetRewoundMissMargin(TestChar, StartLocation, EndTrace, PredictionTime);
+            if (Margin < BestMargin)
+            {
+                BestMargin = Margin;
+                NearestChar = TestChar;
+            }
+        }
+    }
+    if (NearestChar)
+    {
+        Shot.NearMissMargin = BestMargin;
+        Shot.NearMissTargetId = NearestChar->PlayerState ? NearestChar->PlayerState->PlayerId : NPAUDIT_NO_ID;
+        Shot.RewindDistance = (NearestChar->GetActorLocation() - NearestChar->GetRewindLocation(PredictionTime)).Size();
+        if (DiagLevel >= 2 && BestMargin < 80.f) // only log if reasonably close
+        {
+            UE_LOG(LogUTWeaponFix, Log, TEXT("[HitDiag] NEAR MISS. Nearest: %s | Missed Capsule By: %.2f units | RewindTime: %.3fms | RewindDist: %.1f"),
+                *NearestChar->GetName(), BestMargin, Shot.RewindMs, Shot.RewindDistance);
+        }
+    }
+}
+#endif
+
+void AUTWeaponFix::RecordHitAudit(const FHitResult& Hit, const FVector& StartLocation, const FVector& EndTrace, float PredictionTime, bool bHeadSphereHit)
+{
+    // --- HIT AUDIT: one packed record per server shot, written off-thread ---
+    // np.HitDiag 2 logs without np.AuditLog, so build the record for either
+    const bool bAudit = FNetcodePlusAuditLog::IsEnabled();
+    const int32 DiagLevel = FNetcodePlusAuditLog::GetDiagnosticsLevel();
+    if ((!bAudit && DiagLevel < 2) || UTOwner == nullptr)
+    {
+        return;
+    }
+
+    AUTCharacter* ServerHitChar = Cast<AUTCharacter>(Hit.Actor.Get());
+    AUTCharacter* ClaimedChar = ReceivedHitScanHitChar;
+    AUTPlayerState* PS = UTOwner->Controller ? Cast<AUTPlayerState>(UTOwner->Controller->PlayerState) : nullptr;
+
+    FNPAuditShot Shot;
+    FMemory::Memzero(Shot);
+    Shot.ServerTime = GetWorld()->GetTimeSeconds();
+    Shot.ShooterId = PS ? PS->PlayerId : NPAUDIT_NO_ID;
+    Shot.ClaimedTargetId = (ClaimedChar && ClaimedChar->PlayerState) ? ClaimedChar->PlayerState->PlayerId : NPAUDIT_NO_ID;
+    Shot.ServerHitId = (ServerHitChar && ServerHitChar->PlayerState) ? ServerHitChar->PlayerState->PlayerId : NPAUDIT_NO_ID;
+    Shot.RewindMs = PredictionTime * 1000.f;
+    Shot.MissMargin = ClaimedChar ? GetRewoundMissMargin(ClaimedChar, StartLocation, EndTrace, PredictionTime) : NPAUDIT_NO_MARGIN;
+    Shot.PingMs = PS ? (uint16)FMath::Clamp(FMath::RoundToInt(PS->ExactPing), 0, 65535) : 0;
+
+    AUTCharacter* SpeedChar = ClaimedChar ? ClaimedChar : ServerHitChar;
+    Shot.TargetSpeed = SpeedChar ? (uint16)FMath::Clamp(FMath::RoundToInt(SpeedChar->GetVelocity().Size()), 0, 65535) : 0;
+    Shot.FireMode = CurrentFireMode;
+
+    if (ClaimedChar)
+    {
+        Shot.Result = (ServerHitChar == ClaimedChar) ? NPAuditShot_Confirmed : NPAuditShot_Rejected;
+    }
+    else
+    {
+        Shot.Result = ServerHitChar ? NPAuditShot_ServerOnly : NPAuditShot_Miss;
+    }
+
+    if (SpeedChar && SpeedChar->GetVelocity().SizeSquared() > 1.f)
+    {
+        Shot.Flags |= NPAuditFlag_TargetMoving;
+    }
+    if (bHeadSphereHit)
+    {
+        Shot.Flags |= NPAuditFlag_Headshot;
+    }
+    if (Cast<AUTBot>(UTOwner->Controller) != nullptr)
+    {
+        Shot.Flags |= NPAuditFlag_Bot;
+    }
+
+#if NETCODEPLUS_DIAGNOSTICS
+    if (DiagLevel > 0)
+    {
+        AddHitDiagnostics(SpeedChar, StartLocation, EndTrace, PredictionTime, DiagLevel, Shot);
+    }
+#endif
+
+    if (bAudit)
+    {
+        FNetcodePlusAuditLog::RecordShot(GetWorld(), GetClass(), Shot);
+    }
+}
+
 void AUTWeaponFix::DetachFromOwner_Implementation()
 {
     // Safety: Kill timers if the weapon is destroyed or dropped
@@ -2000,6 +2099,8 @@ bool AUTWeaponFix::PutDown()
 
 void AUTWeaponFix::FireCone()
 {
+    NETCODEPLUS_SCOPE(STAT_NetcodePlus_FireCone, FireCone);
+
     //UE_LOG(LogUTWeapon, Verbose, TEXT("%s::FireCone()"), *GetName());
 
     checkSlow(InstantHitInfo.IsValidIndex(CurrentFireMode));
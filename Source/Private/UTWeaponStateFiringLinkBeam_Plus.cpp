@@ -11,10 +11,72 @@ DEFINE_LOG_CATEGORY_STATIC(LogUTWeaponState, Log, All);
 UUTWeaponStateFiringLinkBeamPlus::UUTWeaponStateFiringLinkBeamPlus(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
 {
-    ClientDamageAccumulator = 0.f;
     bPendingEndFire = false;
     bPendingStartFire = false;
     bHasBegun = false;
+    BeamTraceRate = 120.f;
+    BeamTraceAccumulator = 0.f;
+    bHasBeamSample = false;
+    PrevBeamEndpoint = FVector::ZeroVector;
+    LastBeamEndpoint = FVector::ZeroVector;
+    bLastSampleCausingDamage = false;
+}
+
+bool UUTWeaponStateFiringLinkBeamPlus::ConsumeBeamTraceStep(float DeltaTime, float& OutStepTime)
+{
+    // First sample of the sequence, or fixed rate disabled: trace now and cover this frame
+    if (BeamTraceRate <= 0.f || !bHasBeamSample)
+    {
+        BeamTraceAccumulator = 0.f;
+        OutStepTime = DeltaTime;
+        return true;
+    }
+
+    const float TraceInterval = 1.f / BeamTraceRate;
+    BeamTraceAccumulator += DeltaTime;
+    if (BeamTraceAccumulator < TraceInterval)
+    {
+        OutStepTime = 0.f;
+        return false;
+    }
+
+    // One trace covers every whole step that elapsed (low FPS / hitch), so damage time is
+    // exactly NumSteps * TraceInterval and the remainder carries to the next sample.
+    const int32 NumSteps = FMath::FloorToInt(BeamTraceAccumulator / TraceInterval);
+    OutStepTime = NumSteps * TraceInterval;
+    BeamTraceAccumulator -= OutStepTime;
+    return true;
+}
+
+FVector UUTWeaponStateFiringLinkBeamPlus::GetInterpolatedBeamEndpoint() const
+{
+    if (BeamTraceRate <= 0.f)
+    {
+        return LastBeamEndpoint;
+    }
+    const float Alpha = FMath::Clamp(BeamTraceAccumulator * BeamTraceRate, 0.f, 1.f);
+    return FMath::Lerp(PrevBeamEndpoint, LastBeamEndpoint, Alpha);
+}
+
+void UUTWeaponStateFiringLinkBeamPlus::PushBeamSample(const FVector& Endpoint)
+{
+    PrevBeamEndpoint = bHasBeamSample ? LastBeamEndpoint : Endpoint;
+    LastBeamEndpoint = Endpoint;
+    bHasBeamSample = true;
+}
+
+void UUTWeaponStateFiringLinkBeamPlus::TraceBeam(AUTWeap_LinkGun_Plus* LinkGun, FHitResult& Hit)
+{
+    // Suppress stats so beam traces don't spam accuracy
+    FName RealShots = LinkGun->ShotsStatsName;
+    FName RealHits = LinkGun->HitsStatsName;
+    LinkGun->ShotsStatsName = NAME_None;
+    LinkGun->HitsStatsName = NAME_None;
+
+    LinkGun->FireInstantHit(false, &Hit);
+
+    LinkGun->ShotsStatsName = RealShots;
+    LinkGun->HitsStatsName = RealHits;
 }
 
 
@@ -93,6 +155,11 @@ void UUTWeaponStateFiringLinkBeamPlus::BeginState(const UUTWeaponState* Prev)
         LinkGun->LastBeamActivityTime = GetWorld()->GetTimeSeconds();
     }
 
+    // Fresh sequence: first Tick traces immediately instead of waiting a step
+    BeamTraceAccumulator = 0.f;
+    bHasBeamSample = false;
+    bLastSampleCausingDamage = false;
+
     // Do what UUTWeaponStateFiring::BeginState does, but SKIP FireShot()
     GetOuterAUTWeapon()->GetWorldTimerManager().SetTimer(
         RefireCheckHandle,
@@ -278,6 +345,22 @@ void UUTWeaponStateFiringLinkBeamPlus::Tick(float DeltaTime)
     }
     bPendingStartFire = false;
 
+    // --- FIXED-RATE BEAM: only trace when a step is due ---
+    // In-between frames keep the last sample's state and just slide the visual endpoint.
+    float StepTime = 0.f;
+    if (!ConsumeBeamTraceStep(DeltaTime, StepTime))
+    {
+        if (LinkGun->Role == ROLE_Authority)
+        {
+            LinkGun->bLinkCausingDamage = bLastSampleCausingDamage;
+        }
+        if (LinkGun->GetUTOwner()->IsLocallyControlled())
+        {
+            LinkGun->GetUTOwner()->SetFlashLocation(GetInterpolatedBeamEndpoint(), LinkGun->GetCurrentFireMode());
+        }
+        return;
+    }
+
     // --------------------------------------------------------
     // 1) SERVER: dedicated / remote simulation for visuals only
     // --------------------------------------------------------
@@ -290,16 +373,8 @@ void UUTWeaponStateFiringLinkBeamPlus::Tick(float DeltaTime)
         FHitResult Hit;
         const uint8 FireMode = LinkGun->GetCurrentFireMode();
 
-        // Suppress stats so beam traces don't spam accuracy
-        FName RealShots = LinkGun->ShotsStatsName;
-        FName RealHits = LinkGun->HitsStatsName;
-        LinkGun->ShotsStatsName = NAME_None;
-        LinkGun->HitsStatsName = NAME_None;
-
-        LinkGun->FireInstantHit(false, &Hit);
-
-        LinkGun->ShotsStatsName = RealShots;
-        LinkGun->HitsStatsName = RealHits;
+        TraceBeam(LinkGun, Hit);
+        PushBeamSample(Hit.Location);
 
         // Replicated beam is hitting flag
         LinkGun->bLinkBeamImpacting = (Hit.Time < 1.f);
@@ -315,6 +390,7 @@ void UUTWeaponStateFiringLinkBeamPlus::Tick(float DeltaTime)
 
         // For other clients audio/HUD we still want to know if beam is hitting something
         LinkGun->bLinkCausingDamage = Hit.Actor.IsValid() && Hit.Actor->bCanBeDamaged;
+        bLastSampleCausingDamage = LinkGun->bLinkCausingDamage;
 
         // OPTIONAL: you can mirror the warmup timer here if you ever
         // need server-auth decisions about pull readiness for spectators.
@@ -340,18 +416,12 @@ void UUTWeaponStateFiringLinkBeamPlus::Tick(float DeltaTime)
         const uint8 FireMode = LinkGun->GetCurrentFireMode();
 
         // Same stats suppression as Epic
-        FName RealShots = LinkGun->ShotsStatsName;
-        FName RealHits = LinkGun->HitsStatsName;
-        LinkGun->ShotsStatsName = NAME_None;
-        LinkGun->HitsStatsName = NAME_None;
-
-        LinkGun->FireInstantHit(false, &Hit);
-
-        LinkGun->ShotsStatsName = RealShots;
-        LinkGun->HitsStatsName = RealHits;
+        TraceBeam(LinkGun, Hit);
+        PushBeamSample(Hit.Location);
 
-        // 2a) Update visual beam location immediately (owner)
-        LinkGun->GetUTOwner()->SetFlashLocation(Hit.Location, FireMode);
+        // 2a) Update visual beam location (owner) - interpolated so the endpoint moves
+        // smoothly between fixed-rate samples instead of stepping at BeamTraceRate
+        LinkGun->GetUTOwner()->SetFlashLocation(GetInterpolatedBeamEndpoint(), FireMode);
 
         // 2b) Track beam impact + linked target for pull logic
         LinkGun->bLinkBeamImpacting = (Hit.Time < 1.f);
@@ -370,17 +440,20 @@ void UUTWeaponStateFiringLinkBeamPlus::Tick(float DeltaTime)
             LinkGun->bLinkCausingDamage = true;
 
             // 2c) Your client-side damage batching
+            // StepTime is a whole number of fixed steps, so accumulated damage is exact
+            // for the beam's on-target time regardless of frame rate.
             LinkGun->ProcessClientSideHit(
-                DeltaTime,
+                StepTime,
                 Hit.Actor.Get(),
                 Hit.Location,
                 LinkGun->InstantHitInfo[FireMode]);
         }
         else
         {
-            // Miss: clear accumulator so we dont store damage off-target
-            ClientDamageAccumulator = 0.f;
+            // Miss: close the damage session so we dont store damage off-target
+            LinkGun->EndBeamHitStream();
         }
+        bLastSampleCausingDamage = LinkGun->bLinkCausingDamage;
 
         // 2d) Pull warmup logic (same semantics as stock Link)
         if (OldLinkedTarget != LinkGun->CurrentLinkedTarget)
@@ -445,23 +518,18 @@ void UUTWeaponStateFiringLinkBeamPlus::EndState()
     bPendingStartFire = false;
     bPendingEndFire = false;
     bHasBegun = false;
-    ClientDamageAccumulator = 0.f;
+    bHasBeamSample = false;
+    BeamTraceAccumulator = 0.f;
 
     AUTWeap_LinkGun_Plus* LinkGun = Cast<AUTWeap_LinkGun_Plus>(GetOuterAUTWeapon());
     if (LinkGun)
     {
 
         // If we have damage leftover (e.g. 14 damage on a 15 batch), send it NOW.
-        // We must do this BEFORE clearing CurrentLinkedTarget.
-        if (ClientDamageAccumulator >= 1.0f && LinkGun->CurrentLinkedTarget != nullptr)
+        // The session end carries the final cumulative total, and goes out before ServerStopBeamFiring.
+        if (LinkGun->GetUTOwner() && LinkGun->GetUTOwner()->IsLocallyControlled())
         {
-            int32 FinalDamage = FMath::TruncToInt(ClientDamageAccumulator);
-            if (FinalDamage > 0)
-            {
-                // We use PulseLoc as an approximation of the hit location since we don't store the last exact impact point
-                // For a beam, the current end point is usually accurate enough.
-                LinkGun->ServerProcessBeamHit(LinkGun->CurrentLinkedTarget, LinkGun->GetUTOwner()->FlashLocation.Position, FinalDamage);
-            }
+            LinkGun->EndBeamHitStream();
         }
 
         LinkGun->bReadyToPull = false;
@@ -6,6 +6,42 @@
 UUTWeaponStateZoomingFix::UUTWeaponStateZoomingFix(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	HeadTraceRate = 30.0f;
+	LastHeadTraceTime = -1.0f;
+	HeadTraceDelegate.BindUObject(this, &UUTWeaponStateZoomingFix::OnHeadTraceDone);
+}
+
+UUTWeaponStateZoomingFix::FZoomHeadVisibility& UUTWeaponStateZoomingFix::FindOrAddHeadVisibility(AUTCharacter* EnemyChar)
+{
+	for (FZoomHeadVisibility& Entry : HeadVisibility)
+	{
+		if (Entry.Char.Get() == EnemyChar)
+		{
+			return Entry;
+		}
+	}
+	FZoomHeadVisibility& NewEntry = HeadVisibility[HeadVisibility.AddDefaulted()];
+	NewEntry.Char = EnemyChar;
+	NewEntry.bVisible = false;
+	return NewEntry;
+}
+
+void UUTWeaponStateZoomingFix::OnHeadTraceDone(const FTraceHandle& Handle, FTraceDatum& Data)
+{
+	for (FZoomHeadVisibility& Entry : HeadVisibility)
+	{
+		if (Entry.PendingTrace == Handle)
+		{
+			bool bBlocked = false;
+			for (const FHitResult& Hit : Data.OutHits)
+			{
+				bBlocked |= Hit.bBlockingHit;
+			}
+			Entry.bVisible = !bBlocked;
+			Entry.PendingTrace = FTraceHandle();
+			return;
+		}
+	}
 }
 
 bool UUTWeaponStateZoomingFix::DrawHUD(UUTHUDWidget* WeaponHudWidget)
@@ -42,6 +78,15 @@ bool UUTWeaponStateZoomingFix::DrawHUD(UUTHUDWidget* WeaponHudWidget)
                 AUTGameState* GS = GetWorld()->GetGameState<AUTGameState>();
                 float WorldTime = GetWorld()->TimeSeconds;
                 FVector FireStart = GetOuterAUTWeapon()->GetFireStartLoc();
+                static FName NAME_SniperZoom(TEXT("SniperZoom"));
+
+                // --- THROTTLED VISIBILITY: async head traces at HeadTraceRate, results cached per pawn ---
+                const bool bIssueTraces = (HeadTraceRate <= 0.0f) || (WorldTime - LastHeadTraceTime >= 1.0f / HeadTraceRate) || (WorldTime < LastHeadTraceTime);
+                if (bIssueTraces)
+                {
+                    LastHeadTraceTime = WorldTime;
+                    HeadVisibility.RemoveAll([](const FZoomHeadVisibility& Entry) { return !Entry.Char.IsValid(); });
+                }
 
                 for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
                 {
@@ -55,10 +100,17 @@ bool UUTWeaponStateZoomingFix::DrawHUD(UUTHUDWidget* WeaponHudWidget)
                         (GS == NULL || !GS->OnSameTeam(EnemyChar, GetUTOwner())))
                     {
                         FVector HeadLoc = EnemyChar->GetHeadLocation();
-                        static FName NAME_SniperZoom(TEXT("SniperZoom"));
+                        FZoomHeadVisibility& Visibility = FindOrAddHeadVisibility(EnemyChar);
+
+                        // Visibility Check (Is the head behind a wall?) - result arrives next frame via OnHeadTraceDone.
+                        // A newer trace simply replaces an unfinished one; its late result won't match the handle.
+                        if (bIssueTraces)
+                        {
+                            Visibility.PendingTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Test, FireStart, HeadLoc, COLLISION_TRACE_WEAPONNOCHARACTER,
+                                FCollisionQueryParams(NAME_SniperZoom, true, GetUTOwner()), FCollisionResponseParams::DefaultResponseParam, &HeadTraceDelegate);
+                        }
 
-                        // Visibility Check (Is the head behind a wall?)
-                        if (!GetWorld()->LineTraceTestByChannel(FireStart, HeadLoc, COLLISION_TRACE_WEAPONNOCHARACTER, FCollisionQueryParams(NAME_SniperZoom, true, GetUTOwner())))
+                        if (Visibility.bVisible)
                         {
                             // --- CHANGED: REMOVED PING CALCULATION ---
                             // We trust the Rewind. We only draw what is visually there.
@@ -5,6 +5,16 @@
 #include "Modules/ModuleManager.h"
 #include "Modules/ModuleInterface.h"
 
+/** "stat NetcodePlus" */
+DECLARE_STATS_GROUP(TEXT("NetcodePlus"), STATGROUP_NetcodePlus, STATCAT_Advanced);
+
+/**
+ * Opt-in hit-registration diagnostics (np.HitDiag): near-miss scans, rewind distances and their
+ * log lines. 0 compiles them out entirely; add a definition in NetcodePlus.Build.cs to override.
+ */
+#ifndef NETCODEPLUS_DIAGNOSTICS
+#define NETCODEPLUS_DIAGNOSTICS (!UE_BUILD_SHIPPING)
+#endif
 
 class FNetcodePlus : public IModuleInterface
 {
@@ -0,0 +1,113 @@
+// NetcodePlusAuditFormat.h
+// On-disk layout of the hit-registration audit log (*.npaudit). Engine-free on purpose: the plugin
+// writes it (FNetcodePlusAuditLog) and Tools/NetcodePlusAudit reads it, so keep this header to
+// <stdint.h> and plain structs. Everything is little-endian and packed.
+//
+// File  = FNPAuditFileHeader, then a stream of [FNPAuditRecordHeader][payload].
+// Readers skip record types they don't know and read min(Size, sizeof(struct)) of known ones, so
+// fields may be appended to a payload without bumping the version. Reordering/removing needs a bump.
+
+#pragma once
+#include <stdint.h>
+
+#define NPAUDIT_MAGIC          0x4155504Eu   // "NPUA"
+#define NPAUDIT_VERSION        1
+#define NPAUDIT_NAME_LEN       64
+
+/** ShooterId / target ids when there is no character (world hit, no claim) */
+#define NPAUDIT_NO_ID          (-1)
+/** MissMargin when there was no claimed target to measure against */
+#define NPAUDIT_NO_MARGIN      (-99999.f)
+
+#pragma pack(push, 1)
+
+struct FNPAuditFileHeader
+{
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t HeaderSize;
+    /** Wall clock at file open, unix ms */
+    uint64_t StartUnixMs;
+    /** Net tick rate of the server, for context when comparing runs */
+    float ServerTickRate;
+    char MapName[NPAUDIT_NAME_LEN];
+};
+
+enum ENPAuditRecordType
+{
+    /** FNPAuditWeaponName: maps a WeaponId used by later shots to a class name */
+    NPAuditRecord_WeaponName = 1,
+    /** FNPAuditShot */
+    NPAuditRecord_Shot = 2,
+};
+
+struct FNPAuditRecordHeader
+{
+    uint8_t Type;
+    /** Payload bytes following this header */
+    uint16_t Size;
+};
+
+struct FNPAuditWeaponName
+{
+    uint8_t WeaponId;
+    char Name[NPAUDIT_NAME_LEN];
+};
+
+enum ENPAuditShotResult
+{
+    /** Client claimed a character and the server trace agreed */
+    NPAuditShot_Confirmed = 0,
+    /** Client claimed a character, server hit something else or nothing */
+    NPAuditShot_Rejected = 1,
+    /** No claim, server hit a character anyway */
+    NPAuditShot_ServerOnly = 2,
+    /** No claim, no character hit */
+    NPAuditShot_Miss = 3,
+};
+
+enum ENPAuditShotFlags
+{
+    /** Claimed target was moving (padded capsule applied) */
+    NPAuditFlag_TargetMoving = 1 << 0,
+    /** Final hit came from the headshot sphere test */
+    NPAuditFlag_Headshot = 1 << 1,
+    /** Shooter is a bot (no client claim path) */
+    NPAuditFlag_Bot = 1 << 2,
+    /** RewindDistance / NearMiss* are filled in (server ran with np.HitDiag >= 1) */
+    NPAuditFlag_Diagnostics = 1 << 3,
+};
+
+/** One server-side hitscan shot, 44 bytes (32 before the diagnostics fields were appended) */
+struct FNPAuditShot
+{
+    /** World time seconds on the server */
+    float ServerTime;
+    /** PlayerState->PlayerId */
+    int32_t ShooterId;
+    int32_t ClaimedTargetId;
+    int32_t ServerHitId;
+    /** Rewind applied to pawns for this shot */
+    float RewindMs;
+    /** Distance from the shot line to the claimed target's rewound capsule skin; <= 0 is inside */
+    float MissMargin;
+    /** Shooter ping (ExactPing), ms */
+    uint16_t PingMs;
+    /** Speed of the claimed target, or the server hit target if nothing was claimed, uu/s */
+    uint16_t TargetSpeed;
+    uint8_t WeaponId;
+    uint8_t FireMode;
+    /** ENPAuditShotResult */
+    uint8_t Result;
+    /** ENPAuditShotFlags */
+    uint8_t Flags;
+
+    // Valid with NPAuditFlag_Diagnostics only
+    /** How far the rewind moved the claimed / server hit / near-miss target, uu */
+    float RewindDistance;
+    /** Unclaimed misses: MissMargin to the nearest rewound pawn, else NPAUDIT_NO_MARGIN */
+    float NearMissMargin;
+    int32_t NearMissTargetId;
+};
+
+#pragma pack(pop)
@@ -0,0 +1,48 @@
+// NetcodePlusAuditLog.h
+// Server-side hit-registration audit log. One FNPAuditShot per hitscan shot (claimed target,
+// server result, rewind, miss margin, ping, target speed, weapon) is pushed onto a lock-free
+// queue on the game thread and written by a background thread to
+//   Saved/Logs/NetcodePlus/Audit-<Map>-<Date>.npaudit
+// One file per match: the file is opened on the first shot and closed on world cleanup.
+//   np.AuditLog 1    - enable recording (server)
+//   np.HitDiag 1|2   - add near-miss / rewind-distance diagnostics to the records; 2 also logs
+//                      rejected claims and near misses (needs NETCODEPLUS_DIAGNOSTICS)
+// Read the files with Tools/NetcodePlusAudit (format in NetcodePlusAuditFormat.h).
+
+#pragma once
+#include "NetcodePlus.h"
+#include "NetcodePlusAuditFormat.h"
+
+class FNetcodePlusAuditWriter;
+
+class NETCODEPLUS_API FNetcodePlusAuditLog
+{
+public:
+    /** np.AuditLog; cheap, check before building a record */
+    static bool IsEnabled();
+
+    /** np.HitDiag: 0 off, 1 diagnostics in audit records, 2 also log lines. Always 0 when compiled out. */
+#if NETCODEPLUS_DIAGNOSTICS
+    static int32 GetDiagnosticsLevel();
+#else
+    static FORCEINLINE int32 GetDiagnosticsLevel() { return 0; }
+#endif
+
+    /** Queue a shot. Fills in WeaponId from WeaponClass (emitting the name record the first time). Game thread only. */
+    static void RecordShot(UWorld* World, UClass* WeaponClass, FNPAuditShot& Shot);
+
+    /** Flush and close the current file, stopping the writer thread */
+    static void Close();
+
+    /** Hooked up by the module */
+    static void RegisterWorldDelegates();
+    static void UnregisterWorldDelegates();
+
+private:
+    static FNetcodePlusAuditWriter* Writer;
+    static TMap<FName, uint8> WeaponIds;
+    static FDelegateHandle WorldCleanupHandle;
+
+    static bool Open(UWorld* World);
+    static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+};
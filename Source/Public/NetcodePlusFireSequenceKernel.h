@@ -0,0 +1,67 @@
+// NetcodePlusFireSequenceKernel.h
+// The decisions behind the transactional fire pipeline, with no engine dependency: event index
+// windowing, client and server refire gates, timestamp sanity, server rhythm compensation and the
+// client's retry wait. AUTWeaponFix calls these from StartFire / ValidateFireRequest /
+// ServerStartFireFixed; Tools/NetcodePlusFireSim drives the same functions through a simulated
+// client, server and impaired transport, so the harness tests the rules the game ships.
+
+#pragma once
+#include <stdint.h>
+
+namespace NetcodePlusFireSequence
+{
+    /** Server accepts event indices up to this far ahead of the last one it processed */
+    const int32_t EventIndexWindow = 10;
+    /** Client may start a shot this early (s) relative to the refire time */
+    const float ClientRefireTolerance = 0.05f;
+    /** Server accepts a shot this early (s); must stay above the client tolerance */
+    const float ServerRefireTolerance = 0.06f;
+    /** Client timestamps further than this (s) from server time are rejected */
+    const float MaxTimestampDesync = 1.0f;
+    /** Shots arriving within this (s) of their expected slot keep the server's refire rhythm */
+    const float RhythmSnapWindow = 0.20f;
+    /** Client retry lands this long (s) after the cooldown actually ends */
+    const float RetryPadding = 0.01f;
+    /** Client retry poll when the cooldown is (nearly) over but firing was still blocked */
+    const float RetryPollDelay = 0.01f;
+
+    /** Server: is InEventIndex newer than LastProcessed and inside the window? */
+    inline bool IsEventIndexValid(int32_t LastProcessed, int32_t InEventIndex)
+    {
+        return (InEventIndex > LastProcessed) && (InEventIndex <= LastProcessed + EventIndexWindow);
+    }
+
+    /** Is a mode that last fired at LastFireTime (<= 0 = never) still recovering at Now? */
+    inline bool IsModeRecovering(float LastFireTime, float RefireTime, float Now, float Tolerance)
+    {
+        return LastFireTime > 0.0f && (Now - LastFireTime) < (RefireTime - Tolerance);
+    }
+
+    inline bool IsTimestampDesynced(float ServerTime, float ClientTime)
+    {
+        const float TimeDiff = ServerTime > ClientTime ? ServerTime - ClientTime : ClientTime - ServerTime;
+        return TimeDiff > MaxTimestampDesync;
+    }
+
+    /**
+     * Server: the LastFireTime to store for an accepted shot. A shot that arrives roughly on time
+     * is booked at its theoretical slot (LastFireTime + Refire) so network jitter doesn't
+     * accumulate into the refire check; a late one (player paused) restarts the rhythm at Now.
+     */
+    inline float CompensatedFireTime(float LastFireTime, float RefireTime, float Now)
+    {
+        if (LastFireTime <= 0.0f)
+        {
+            return Now;
+        }
+        const float TheoreticalFireTime = LastFireTime + RefireTime;
+        return (Now < TheoreticalFireTime + RhythmSnapWindow) ? TheoreticalFireTime : Now;
+    }
+
+    /** Client: how long to wait before retrying a blocked StartFire, given when the weapon is ready */
+    inline float RetryDelay(float MaxReadyTime, float Now)
+    {
+        const float Delay = MaxReadyTime - Now;
+        return (Delay > RetryPollDelay) ? Delay + RetryPadding : RetryPollDelay;
+    }
+}
@@ -0,0 +1,271 @@
+// NetcodePlusLagCompKernel.h
+// The math behind server hit validation, with no engine dependency: rewind interpolation over a
+// saved-position history and the ray-vs-(padded, slide-adjusted) capsule test. AUTWeaponFix and
+// ATeamArenaCharacter call these with FVector / FSavedPosition; Tools/ (session replayer,
+// benchmarks) call them with FNPVec3 / their own samples, so an offline run executes exactly the
+// code the server does.
+//
+// Vector type V needs public float X, Y, Z, a V(float, float, float) constructor and +, - and
+// V * float. Sample type S needs V Position, float Time and bool bTeleported.
+
+#pragma once
+#include <stdint.h>
+
+namespace NetcodePlusLagComp
+{
+    /** Minimal vector for engine-free users of the kernel */
+    struct FNPVec3
+    {
+        float X, Y, Z;
+
+        FNPVec3() : X(0.f), Y(0.f), Z(0.f) {}
+        FNPVec3(float InX, float InY, float InZ) : X(InX), Y(InY), Z(InZ) {}
+
+        FNPVec3 operator+(const FNPVec3& V) const { return FNPVec3(X + V.X, Y + V.Y, Z + V.Z); }
+        FNPVec3 operator-(const FNPVec3& V) const { return FNPVec3(X - V.X, Y - V.Y, Z - V.Z); }
+        FNPVec3 operator*(float Scale) const { return FNPVec3(X * Scale, Y * Scale, Z * Scale); }
+    };
+
+    template <typename V>
+    inline float Dot(const V& A, const V& B)
+    {
+        return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+    }
+
+    template <typename V>
+    inline float DistSquared(const V& A, const V& B)
+    {
+        const V D = A - B;
+        return Dot(D, D);
+    }
+
+    /** Same as FMath::ClosestPointOnSegment */
+    template <typename V>
+    inline V ClosestPointOnSegment(const V& Point, const V& StartPoint, const V& EndPoint)
+    {
+        const V Segment = EndPoint - StartPoint;
+        const V VectToPoint = Point - StartPoint;
+
+        const float Dot1 = Dot(VectToPoint, Segment);
+        if (Dot1 <= 0.f)
+        {
+            return StartPoint;
+        }
+        const float Dot2 = Dot(Segment, Segment);
+        if (Dot2 <= Dot1)
+        {
+            return EndPoint;
+        }
+        return StartPoint + Segment * (Dot1 / Dot2);
+    }
+
+    /** Same as FMath::SegmentDistToSegmentSafe: closest points between segments A1-B1 and A2-B2 */
+    template <typename V>
+    inline void SegmentDistToSegmentSafe(const V& A1, const V& B1, const V& A2, const V& B2, V& OutP1, V& OutP2)
+    {
+        const V S1 = B1 - A1;
+        const V S2 = B2 - A2;
+        const V S3 = A1 - A2;
+
+        const float Dot11 = Dot(S1, S1);
+        const float Dot22 = Dot(S2, S2);
+        const float Dot12 = Dot(S1, S2);
+        const float Dot13 = Dot(S1, S3);
+        const float Dot23 = Dot(S2, S3);
+
+        const float Epsilon = 1.e-8f;
+
+        float N1, N2;
+        const float D = Dot11 * Dot22 - Dot12 * Dot12;
+        float D1 = D;
+        float D2 = D;
+
+        if (D < Epsilon)
+        {
+            // almost parallel: use A1
+            N1 = 0.f;
+            D1 = 1.f;
+            N2 = Dot23;
+            D2 = Dot22;
+        }
+        else
+        {
+            N1 = (Dot12 * Dot23 - Dot22 * Dot13);
+            N2 = (Dot11 * Dot23 - Dot12 * Dot13);
+
+            if (N1 < 0.f)
+            {
+                N1 = 0.f;
+                N2 = Dot23;
+                D2 = Dot22;
+            }
+            else if (N1 > D1)
+            {
+                N1 = D1;
+                N2 = Dot23 + Dot12;
+                D2 = Dot22;
+            }
+        }
+
+        if (N2 < 0.f)
+        {
+            N2 = 0.f;
+            if (-Dot13 < 0.f)
+            {
+                N1 = 0.f;
+            }
+            else if (-Dot13 > Dot11)
+            {
+                N1 = D1;
+            }
+            else
+            {
+                N1 = -Dot13;
+                D1 = Dot11;
+            }
+        }
+        else if (N2 > D2)
+        {
+            N2 = D2;
+            if ((-Dot13 + Dot12) < 0.f)
+            {
+                N1 = 0.f;
+            }
+            else if ((-Dot13 + Dot12) > Dot11)
+            {
+                N1 = D1;
+            }
+            else
+            {
+                N1 = (-Dot13 + Dot12);
+                D1 = Dot11;
+            }
+        }
+
+        const float T1 = ((N1 < 0.f ? -N1 : N1) < Epsilon) ? 0.f : N1 / D1;
+        const float T2 = ((N2 < 0.f ? -N2 : N2) < Epsilon) ? 0.f : N2 / D2;
+
+        OutP1 = A1 + S1 * T1;
+        OutP2 = A2 + S2 * T2;
+    }
+
+    /** Extra output from RewindLocation, for the rewind debug draw */
+    template <typename V>
+    struct TRewindInfo
+    {
+        V PrePosition;
+        V PostPosition;
+        float Percent;
+        bool bTeleported;
+    };
+
+    /**
+     * Position at TargetTime from a history sorted by Time (oldest first). Interpolates between the
+     * bracketing samples unless the older one teleported; falls back to Current if the history is
+     * empty or doesn't reach back that far. This is the UT GetRewindLocation walk.
+     */
+    template <typename S, typename V>
+    inline V RewindLocation(const S* Samples, int32_t NumSamples, const V& Current, float TargetTime, TRewindInfo<V>* OutInfo = nullptr)
+    {
+        V TargetLocation = Current;
+        V PrePosition = Current;
+        V PostPosition = Current;
+        float Percent = 0.999f;
+        bool bTeleported = false;
+
+        for (int32_t i = NumSamples - 1; i >= 0; i--)
+        {
+            TargetLocation = Samples[i].Position;
+            if (Samples[i].Time < TargetTime)
+            {
+                if (!Samples[i].bTeleported && (i < NumSamples - 1))
+                {
+                    PrePosition = Samples[i].Position;
+                    PostPosition = Samples[i + 1].Position;
+                    if (Samples[i + 1].Time == Samples[i].Time)
+                    {
+                        Percent = 1.f;
+                        TargetLocation = Samples[i + 1].Position;
+                    }
+                    else
+                    {
+                        Percent = (TargetTime - Samples[i].Time) / (Samples[i + 1].Time - Samples[i].Time);
+                        TargetLocation = Samples[i].Position + (Samples[i + 1].Position - Samples[i].Position) * Percent;
+                    }
+                }
+                else
+                {
+                    bTeleported = Samples[i].bTeleported;
+                }
+                break;
+            }
+        }
+
+        if (OutInfo)
+        {
+            OutInfo->PrePosition = PrePosition;
+            OutInfo->PostPosition = PostPosition;
+            OutInfo->Percent = Percent;
+            OutInfo->bTeleported = bTeleported;
+        }
+        return TargetLocation;
+    }
+
+    /** Target capsule as the server sees it for one shot */
+    struct FCapsuleQuery
+    {
+        float Radius;
+        float HalfHeight;
+        /** Floor-sliding targets are tested as a sphere/short capsule of SlideTargetHeight sitting on the floor */
+        bool bSliding;
+        float SlideTargetHeight;
+        /** HitScanPadding / HitScanPaddingStationary when the client claimed this target, else 0 */
+        float ExtraPadding;
+    };
+
+    /**
+     * Does the trace StartLocation -> EndLocation (sweep radius TraceRadius) hit the capsule centred at
+     * TargetLocation? OutClosestPoint is on the trace, OutClosestCapsulePoint on the capsule's axis.
+     */
+    template <typename V>
+    inline bool TraceHitsCapsule(const V& StartLocation, const V& EndLocation, float TraceRadius, V TargetLocation, const FCapsuleQuery& Capsule, V& OutClosestPoint, V& OutClosestCapsulePoint)
+    {
+        float CollisionHeight = Capsule.HalfHeight;
+        if (Capsule.bSliding)
+        {
+            TargetLocation.Z = TargetLocation.Z - CollisionHeight + Capsule.SlideTargetHeight;
+            CollisionHeight = Capsule.SlideTargetHeight;
+        }
+
+        OutClosestCapsulePoint = TargetLocation;
+        if (Capsule.Radius >= CollisionHeight)
+        {
+            OutClosestPoint = ClosestPointOnSegment(TargetLocation, StartLocation, EndLocation);
+            const float Reach = CollisionHeight + TraceRadius + Capsule.ExtraPadding;
+            return DistSquared(OutClosestPoint, TargetLocation) < Reach * Reach;
+        }
+
+        const V CapsuleSegment(0.f, 0.f, CollisionHeight - Capsule.Radius);
+        SegmentDistToSegmentSafe(StartLocation, EndLocation, TargetLocation - CapsuleSegment, TargetLocation + CapsuleSegment, OutClosestPoint, OutClosestCapsulePoint);
+        const float Reach = Capsule.Radius + TraceRadius + Capsule.ExtraPadding;
+        return DistSquared(OutClosestPoint, OutClosestCapsulePoint) < Reach * Reach;
+    }
+
+    /** Claimed targets get padding, more of it if moving (FVector::IsNearlyZero(1.f) test on velocity) */
+    template <typename V>
+    inline float ClaimedTargetPadding(bool bClaimed, const V& Velocity, float MovingPadding, float StationaryPadding)
+    {
+        if (!bClaimed)
+        {
+            return 0.f;
+        }
+        const bool bIsMoving = (Velocity.X > 1.f || Velocity.X < -1.f) || (Velocity.Y > 1.f || Velocity.Y < -1.f) || (Velocity.Z > 1.f || Velocity.Z < -1.f);
+        return bIsMoving ? MovingPadding : StationaryPadding;
+    }
+
+    /** Saved-position trim used by PositionUpdated: keep one sample older than MaxAge for interpolation */
+    inline bool ShouldTrimOldestSample(int32_t NumSamples, float SecondOldestTime, float Now, float MaxAge)
+    {
+        return NumSamples > 1 && SecondOldestTime < Now - MaxAge;
+    }
+}
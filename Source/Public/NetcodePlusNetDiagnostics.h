@@ -0,0 +1,121 @@
+// NetcodePlusNetDiagnostics.h
+// Optional in-game net diagnostics overlay for split prediction and hit registration.
+//   np.NetDiag 1    - show the overlay (client)
+// Turning it on subscribes the owning ATeamArenaPredictionPC on the server, which then keeps
+// rolling 5 s counters (shots confirmed/rejected, rewind of the last shot, position checks and
+// corrections, link beam hit batches) and pushes them to that client at 1-2 Hz. The client adds
+// its own shots sent and clock offset, formats the lines once per push and draws only the cached
+// text each frame. With the overlay off nothing is registered, nothing is sent, and the server
+// hooks are a single branch.
+
+#pragma once
+#include "NetcodePlus.h"
+#include "NetcodePlusNetDiagnostics.generated.h"
+
+class UCanvas;
+
+/** Aggregate the server pushes to a subscribed owning client (unreliable, 1-2 Hz) */
+USTRUCT()
+struct FNetcodePlusNetDiagSnapshot
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** Server world time when the snapshot was built, for the client's clock offset */
+    UPROPERTY()
+    float ServerTime;
+
+    /** Rewind applied to the last validated shot (ms) */
+    UPROPERTY()
+    uint16 RewindMs;
+
+    /** Counts over the last FNetcodePlusNetDiagnostics::WindowSeconds */
+    UPROPERTY()
+    uint16 ShotsConfirmed;
+
+    UPROPERTY()
+    uint16 ShotsRejected;
+
+    UPROPERTY()
+    uint16 PositionChecks;
+
+    UPROPERTY()
+    uint16 PositionCorrections;
+
+    UPROPERTY()
+    uint16 BeamBatches;
+
+    FNetcodePlusNetDiagSnapshot()
+        : ServerTime(0.f)
+        , RewindMs(0)
+        , ShotsConfirmed(0)
+        , ShotsRejected(0)
+        , PositionChecks(0)
+        , PositionCorrections(0)
+        , BeamBatches(0)
+    {
+    }
+};
+
+/**
+ * Rolling counters in one-second buckets. Server side for a subscribed controller; the client
+ * uses ShotsSent for its own RPCs.
+ */
+struct NETCODEPLUS_API FNetcodePlusNetDiagCounters
+{
+    enum { NumBuckets = 5 };
+
+    uint16 ShotsSent[NumBuckets];
+    uint16 ShotsConfirmed[NumBuckets];
+    uint16 ShotsRejected[NumBuckets];
+    uint16 PositionChecks[NumBuckets];
+    uint16 PositionCorrections[NumBuckets];
+    uint16 BeamBatches[NumBuckets];
+    int32 CurrentSecond;
+    float LastRewindMs;
+    /** Movement component totals at the last sample, for deltas */
+    int32 LastNumPositionChecks;
+    int32 LastNumPositionCorrections;
+
+    FNetcodePlusNetDiagCounters() { Reset(); }
+
+    void Reset();
+    /** Rolls the window to Now, clearing buckets for the seconds that passed. Returns the current bucket. */
+    int32 Advance(float Now);
+    void Fill(FNetcodePlusNetDiagSnapshot& Out) const;
+    static uint16 Sum(const uint16* Buckets);
+};
+
+class NETCODEPLUS_API FNetcodePlusNetDiagnostics
+{
+public:
+    /** Seconds covered by the counters */
+    static const int32 WindowSeconds = FNetcodePlusNetDiagCounters::NumBuckets;
+
+    /** np.NetDiag */
+    static bool IsOverlayRequested();
+
+    /** Server: any controller subscribed? Check before calling the Record functions. */
+    static FORCEINLINE bool HasSubscribers() { return NumSubscribers > 0; }
+    static void AddSubscriber() { NumSubscribers++; }
+    static void RemoveSubscriber() { NumSubscribers = FMath::Max(NumSubscribers - 1, 0); }
+
+    /** Client: a local overlay is up. Check before RecordShotSent. */
+    static FORCEINLINE bool IsOverlayActive() { return bOverlayActive; }
+    static void SetOverlayActive(bool bActive) { bOverlayActive = bActive; }
+
+    /** Server: ServerStartFireFixed validated (or refused) a shot from Shooter */
+    static void RecordShot(APawn* Shooter, bool bAccepted, float RewindSeconds);
+    /** Server: a link beam hit batch/stream update arrived from Shooter */
+    static void RecordBeamBatch(APawn* Shooter);
+    /** Client: FireShot sent ServerStartFireFixed */
+    static void RecordShotSent(APawn* Shooter);
+
+    /** Client: formats the overlay lines from a pushed snapshot (once per push, not per frame) */
+    static void BuildOverlayLines(const FNetcodePlusNetDiagSnapshot& Snapshot, const FNetcodePlusNetDiagCounters& ClientCounters, float ClockOffsetMs, TArray<FString>& OutLines);
+    /** Client: draws cached lines; fixed cost of a handful of DrawText calls */
+    static void DrawOverlay(UCanvas* Canvas, const TArray<FString>& Lines, float StatsAge);
+
+private:
+    static int32 NumSubscribers;
+    static bool bOverlayActive;
+};
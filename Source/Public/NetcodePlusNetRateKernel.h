@@ -0,0 +1,60 @@
+// NetcodePlusNetRateKernel.h
+// Adaptive per-viewer replication rate, with no engine dependency: the relevance terms that turn
+// distance, view cone and line of sight into a desired rate, and the per-connection pacing gate.
+// ATeamArenaCharacter calls these from UpdateAdaptiveNetRates / IsReplicationPausedForConnection;
+// Tools/NetcodePlusNetRate runs the same functions over a simulated match to measure the traffic.
+
+#pragma once
+#include <stdint.h>
+
+namespace NetcodePlusNetRate
+{
+    /** Relevance kept for a pawn behind the viewer (they can turn around) */
+    const float OutOfViewScale = 0.3f;
+    /** Relevance kept for a pawn in view but behind cover */
+    const float OccludedScale = 0.4f;
+
+    /** Distance term: 1 inside Near, fading linearly to 0 at Far */
+    inline float DistanceRelevance(float Distance, float NearDistance, float FarDistance)
+    {
+        const float Range = (FarDistance - NearDistance) > 1.0f ? (FarDistance - NearDistance) : 1.0f;
+        float Alpha = (Distance - NearDistance) / Range;
+        Alpha = Alpha < 0.0f ? 0.0f : (Alpha > 1.0f ? 1.0f : Alpha);
+        return 1.0f - Alpha;
+    }
+
+    inline float DesiredRate(float MinRate, float MaxRate, float Relevance)
+    {
+        return MinRate + (MaxRate - MinRate) * Relevance;
+    }
+
+    /**
+     * Per-connection pacing. The actor is considered at the fastest rate any viewer needs; this
+     * decides whether this viewer's connection takes the update. NextTime advances by whole
+     * intervals so the average lands on Rate even though considerations are quantized to the
+     * actor's own update rate. A raised rate takes effect within one new interval and a
+     * connection that fell behind doesn't burst to catch up.
+     */
+    inline bool ShouldReplicate(float& NextTime, float Now, float Rate)
+    {
+        if (Rate <= 0.0f)
+        {
+            return true;
+        }
+        const float Interval = 1.0f / Rate;
+        if (NextTime > Now + Interval)
+        {
+            NextTime = Now + Interval;
+        }
+        if (Now < NextTime)
+        {
+            return false;
+        }
+        NextTime += Interval;
+        if (NextTime <= Now)
+        {
+            NextTime = Now + Interval;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,63 @@
+// NetcodePlusRpcStats.h
+// Per-connection, per-RPC wire accounting for the plugin's RPCs (calls, bits, reliable calls,
+// estimated reliable resends). Actors that own NetcodePlus RPCs wrap CallRemoteFunction in
+// FNetcodePlusRpcStats::FScope.
+//   np.RpcStats        - print the table
+//   np.RpcStatsDump    - write it to Saved/Logs/NetcodePlus/
+//   np.RpcStatsReset   - clear counters
+// The table is also written to file and cleared when the world is cleaned up (match end / map change).
+
+#pragma once
+#include "NetcodePlus.h"
+
+class UNetConnection;
+
+class NETCODEPLUS_API FNetcodePlusRpcStats
+{
+public:
+    /** Measures one outgoing RPC: SendBuffer bits before/after the send on the actor's connection */
+    struct NETCODEPLUS_API FScope
+    {
+        FScope(AActor* Actor, UFunction* Function);
+        ~FScope();
+
+    private:
+        UNetConnection* Connection;
+        UFunction* Function;
+        int64 StartBits;
+    };
+
+    /** Hooked up by the module */
+    static void RegisterWorldDelegates();
+    static void UnregisterWorldDelegates();
+
+    static void Dump(FOutputDevice& Ar);
+    static void DumpToFile(const FString& Reason);
+    static void Reset();
+
+private:
+    struct FRpcCounters
+    {
+        uint32 Calls;
+        uint64 Bits;
+        uint32 ReliableCalls;
+        /** Expected retransmissions of reliable bunches, from the connection's measured outgoing loss */
+        float EstimatedResends;
+
+        FRpcCounters() : Calls(0), Bits(0), ReliableCalls(0), EstimatedResends(0.f) {}
+    };
+
+    struct FConnectionRecord
+    {
+        TWeakObjectPtr<UNetConnection> Connection;
+        FString Name;
+        TMap<FName, FRpcCounters> Rpcs;
+    };
+
+    static TArray<FConnectionRecord> Records;
+    static FDelegateHandle WorldCleanupHandle;
+
+    static FConnectionRecord& FindOrAddRecord(UNetConnection* Connection);
+    static void Record(UNetConnection* Connection, UFunction* Function, int64 Bits);
+    static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+};
@@ -0,0 +1,158 @@
+// NetcodePlusSessionFormat.h
+// On-disk layout of a netcode session recording (*.npsession): everything server hit validation
+// consumes, in the order the server saw it. Written by FNetcodePlusSessionRecorder, replayed by
+// Tools/NetcodePlusReplay against NetcodePlusLagCompKernel.h. Engine-free like the audit format.
+//
+// File = FNPSessionFileHeader, then [FNPSessionRecordHeader][payload] records. Every struct is a
+// multiple of 4 bytes and every record starts 4-byte aligned, so a reader can mmap the file and
+// cast in place. Readers skip unknown types and honour Size, so payloads may grow at the end.
+
+#pragma once
+#include <stdint.h>
+
+#define NPSESSION_MAGIC        0x5253504Eu   // "NPSR"
+#define NPSESSION_VERSION      1
+#define NPSESSION_NAME_LEN     64
+#define NPSESSION_NO_PAWN      (-1)
+
+#pragma pack(push, 4)
+
+struct FNPSessionFileHeader
+{
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t HeaderSize;
+    uint64_t StartUnixMs;
+    char MapName[NPSESSION_NAME_LEN];
+};
+
+enum ENPSessionRecordType
+{
+    /** FNPSessionTick, end of every server frame */
+    NPSessionRecord_Tick = 1,
+    /** FNPSessionPawnAdd, first time a pawn is referenced */
+    NPSessionRecord_PawnAdd = 2,
+    /** FNPSessionPawnMove, every PositionUpdated on the server */
+    NPSessionRecord_PawnMove = 3,
+    /** FNPSessionPawnRemove */
+    NPSessionRecord_PawnRemove = 4,
+    /** FNPSessionFireRpc, ServerStartFireFixed as received */
+    NPSessionRecord_FireRpc = 5,
+    /** FNPSessionBeamRpc, link beam hit RPCs as received */
+    NPSessionRecord_BeamRpc = 6,
+    /** FNPSessionHitScan, one server hitscan validation (input and result) */
+    NPSessionRecord_HitScan = 7,
+};
+
+struct FNPSessionRecordHeader
+{
+    uint16_t Type;
+    /** Payload bytes, multiple of 4 */
+    uint16_t Size;
+};
+
+struct FNPSessionTick
+{
+    float WorldTime;
+    float DeltaTime;
+};
+
+struct FNPSessionPawnAdd
+{
+    int32_t PawnId;
+    int32_t PlayerId;
+    /** Saved positions older than this are trimmed (one extra is kept for interpolation) */
+    float MaxSavedPositionAge;
+    uint8_t TeamNum;
+    uint8_t Pad[3];
+};
+
+enum ENPSessionPawnFlags
+{
+    NPSessionPawn_Sliding = 1 << 0,
+    /** This move was appended to SavedPositions (Location/Time are the sample) */
+    NPSessionPawn_SampleSaved = 1 << 1,
+    NPSessionPawn_Teleported = 1 << 2,
+    NPSessionPawn_ShotSpawned = 1 << 3,
+    NPSessionPawn_Dead = 1 << 4,
+    /** Pre-existing SavedPositions entry written with PawnAdd; adds history only, not current state */
+    NPSessionPawn_HistorySeed = 1 << 5,
+};
+
+struct FNPSessionPawnMove
+{
+    int32_t PawnId;
+    float Time;
+    float Location[3];
+    float Velocity[3];
+    float Radius;
+    float HalfHeight;
+    float SlideTargetHeight;
+    /** ENPSessionPawnFlags */
+    uint32_t Flags;
+};
+
+struct FNPSessionPawnRemove
+{
+    int32_t PawnId;
+    float Time;
+};
+
+struct FNPSessionFireRpc
+{
+    float ReceiveTime;
+    int32_t ShooterPawnId;
+    int32_t EventIndex;
+    float ClientTimestamp;
+    float ViewPitch;
+    float ViewYaw;
+    float ViewRoll;
+    int32_t ClaimedPawnId;
+    uint8_t FireMode;
+    uint8_t bClientPredicted;
+    uint8_t ZOffset;
+    /** ValidateFireRequest passed */
+    uint8_t bAccepted;
+};
+
+enum ENPSessionBeamKind
+{
+    NPSessionBeam_Stream = 0,
+    NPSessionBeam_StreamEnd = 1,
+    /** ServerProcessBeamHit, removed; only found in older recordings */
+    NPSessionBeam_LegacyBatch = 2,
+};
+
+struct FNPSessionBeamRpc
+{
+    float ReceiveTime;
+    int32_t ShooterPawnId;
+    int32_t TargetPawnId;
+    float HitLocation[3];
+    int32_t Damage;
+    uint16_t Sequence;
+    uint8_t SessionId;
+    /** ENPSessionBeamKind */
+    uint8_t Kind;
+};
+
+struct FNPSessionHitScan
+{
+    float Time;
+    int32_t ShooterPawnId;
+    int32_t ClaimedPawnId;
+    /** Pawn the server picked, NPSESSION_NO_PAWN if none */
+    int32_t ResultPawnId;
+    float Start[3];
+    /** End of the pawn pass: the world-trace (and rewound projectile) hit, or the trace end */
+    float PawnTraceEnd[3];
+    float TraceRadius;
+    float PredictionTime;
+    float PaddingMoving;
+    float PaddingStationary;
+    /** Pawns on this team are skipped (teammates don't block); 255 = test everyone */
+    uint8_t SkipTeam;
+    uint8_t Pad[3];
+};
+
+#pragma pack(pop)
@@ -0,0 +1,55 @@
+// NetcodePlusSessionRecorder.h
+// Server-side recorder for everything hit validation consumes: every pawn move/saved position with
+// capsule and slide state, every ServerStartFireFixed and link beam hit payload with its receive
+// time, and the input/result of every hitscan pawn pass. Output is a versioned, mmap-friendly
+//   Saved/Profiling/NetcodePlus/<Name>.npsession
+// (format in NetcodePlusSessionFormat.h) that Tools/NetcodePlusReplay re-runs without the engine.
+//   np.RecordStart [Name]   - start recording the current world (server)
+//   np.RecordStop           - flush and close
+// Recording also stops on world cleanup. Hooks are a single branch when not recording.
+
+#pragma once
+#include "NetcodePlus.h"
+#include "NetcodePlusSessionFormat.h"
+
+class AUTCharacter;
+class AUTWeaponFix;
+
+class NETCODEPLUS_API FNetcodePlusSessionRecorder
+{
+public:
+    static FORCEINLINE bool IsRecording() { return Archive != nullptr; }
+
+    static void Start(UWorld* World, const FString& Name);
+    static void Stop();
+
+    static void RecordPawnMove(AUTCharacter* Pawn, bool bSampleSaved, bool bTeleported, bool bShotSpawned);
+    static void RecordPawnRemoved(AUTCharacter* Pawn);
+    static void RecordFireRpc(AUTWeaponFix* Weapon, uint8 FireMode, int32 EventIndex, float ClientTimestamp, bool bClientPredicted, const FRotator& ViewRot, AUTCharacter* ClaimedChar, uint8 ZOffset, bool bAccepted);
+    static void RecordBeamRpc(AActor* Weapon, AActor* HitActor, const FVector& HitLocation, int32 Damage, uint8 SessionId, uint16 Sequence, uint8 Kind);
+    static void RecordHitScan(AUTWeaponFix* Weapon, AUTCharacter* ClaimedChar, AUTCharacter* ResultChar, const FVector& Start, const FVector& PawnTraceEnd,
+        float TraceRadius, float PredictionTime, float PaddingMoving, float PaddingStationary, uint8 SkipTeam);
+
+    /** Hooked up by the module */
+    static void RegisterWorldDelegates();
+    static void UnregisterWorldDelegates();
+
+private:
+    static FArchive* Archive;
+    static TWeakObjectPtr<UWorld> RecordedWorld;
+    static TArray<uint8> Buffer;
+    static TMap<TWeakObjectPtr<AActor>, int32> PawnIds;
+    static int32 NextPawnId;
+    static FDelegateHandle EndFrameHandle;
+    static FDelegateHandle WorldCleanupHandle;
+
+    template <typename T>
+    static void Write(ENPSessionRecordType Type, const T& Payload);
+    static void Flush();
+    /** Id for Pawn, emitting its PawnAdd the first time; NPSESSION_NO_PAWN for null / non-characters */
+    static int32 GetPawnId(AActor* Pawn);
+    static bool IsRecordedWorld(const AActor* Actor);
+
+    static void OnEndFrame();
+    static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+};
@@ -0,0 +1,116 @@
+// NetcodePlusStats.h
+// Cycle counters for the netcode hot paths ("stat NetcodePlus") plus a lightweight
+// per-frame profiler that can stream the same numbers to CSV in any build config:
+//   np.CsvStart [Name]   - start writing Saved/Profiling/NetcodePlus/<Name>.csv
+//   np.CsvStop           - flush and close
+
+#pragma once
+#include "NetcodePlus.h"
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HitScanTrace"), STAT_NetcodePlus_HitScanTrace, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FireCone"), STAT_NetcodePlus_FireCone, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetRewindLocation"), STAT_NetcodePlus_GetRewindLocation, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ServerStartFireFixed"), STAT_NetcodePlus_ServerStartFire, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ServerBeamHitStream"), STAT_NetcodePlus_ServerBeamHit, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PositionUpdated"), STAT_NetcodePlus_PositionUpdated, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Saved Positions (all pawns)"), STAT_NetcodePlus_SavedPositions, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Head Offset History (all pawns)"), STAT_NetcodePlus_HeadOffsetHistory, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shock Ball History (all balls)"), STAT_NetcodePlus_ShockBallHistory, STATGROUP_NetcodePlus, NETCODEPLUS_API);
+
+/** Hot paths tracked by FNetcodePlusProfiler (CSV columns, in order) */
+namespace ENetcodePlusPath
+{
+    enum Type
+    {
+        HitScanTrace,
+        FireCone,
+        GetRewindLocation,
+        ServerStartFire,
+        ServerBeamHit,
+        PositionUpdated,
+        MAX
+    };
+}
+
+/** Rewind history sizes tracked as running totals */
+namespace ENetcodePlusGauge
+{
+    enum Type
+    {
+        SavedPositions,
+        HeadOffsetHistory,
+        ShockBallHistory,
+        MAX
+    };
+}
+
+class NETCODEPLUS_API FNetcodePlusProfiler
+{
+public:
+    /** Only true while a CSV capture is running; scoped timers cost one branch otherwise */
+    static bool bCapturing;
+
+    static void AddSample(ENetcodePlusPath::Type Path, uint64 Cycles)
+    {
+        PathCycles[Path] += Cycles;
+        PathCalls[Path]++;
+    }
+
+    /** Gauges are kept even when not capturing so a capture starts with correct totals */
+    static void AdjustGauge(ENetcodePlusGauge::Type Gauge, int32 Delta)
+    {
+        GaugeValues[Gauge] += Delta;
+    }
+
+    static void StartCsv(const FString& Name);
+    static void StopCsv();
+
+private:
+    static uint64 PathCycles[ENetcodePlusPath::MAX];
+    static uint32 PathCalls[ENetcodePlusPath::MAX];
+    static int32 GaugeValues[ENetcodePlusGauge::MAX];
+
+    static FArchive* CsvWriter;
+    static FDelegateHandle EndFrameHandle;
+    static double LastFrameTime;
+
+    /** Writes one row and resets the per-frame accumulators */
+    static void OnEndFrame();
+    static void WriteLine(const FString& Line);
+};
+
+/** Times a scope into FNetcodePlusProfiler while a capture is running */
+struct FNetcodePlusScopedTimer
+{
+    ENetcodePlusPath::Type Path;
+    uint64 StartCycles;
+
+    explicit FNetcodePlusScopedTimer(ENetcodePlusPath::Type InPath)
+        : Path(InPath)
+        , StartCycles(FNetcodePlusProfiler::bCapturing ? FPlatformTime::Cycles64() : 0)
+    {
+    }
+
+    ~FNetcodePlusScopedTimer()
+    {
+        if (StartCycles != 0)
+        {
+            FNetcodePlusProfiler::AddSample(Path, FPlatformTime::Cycles64() - StartCycles);
+        }
+    }
+};
+
+/** Stat cycle counter + CSV profiler sample for one hot path */
+#define NETCODEPLUS_SCOPE(StatId, PathName) \
+    SCOPE_CYCLE_COUNTER(StatId); \
+    FNetcodePlusScopedTimer NetcodePlusScope_##PathName(ENetcodePlusPath::PathName)
+
+/** Moves a history-size gauge from OldSize to NewSize (stat accumulator + CSV gauge) */
+#define NETCODEPLUS_GAUGE_UPDATE(StatId, GaugeName, OldSize, NewSize) \
+    { \
+        const int32 NetcodePlusGaugeDelta = int32(NewSize) - int32(OldSize); \
+        if (NetcodePlusGaugeDelta > 0) { INC_DWORD_STAT_BY(StatId, NetcodePlusGaugeDelta); } \
+        else if (NetcodePlusGaugeDelta < 0) { DEC_DWORD_STAT_BY(StatId, -NetcodePlusGaugeDelta); } \
+        FNetcodePlusProfiler::AdjustGauge(ENetcodePlusGauge::GaugeName, NetcodePlusGaugeDelta); \
+    }
@@ -13,6 +13,62 @@
 
 class UTeamArenaCharacterMovement;
 
+/** Server-side adaptive replication state for one viewing player */
+struct FViewerNetRate
+{
+    TWeakObjectPtr<APlayerController> Viewer;
+
+    /** Rate (Hz) this viewer needs us at, from distance/view cone/LOS/engagement */
+    float DesiredRate;
+
+    /** Last time this viewer and we were in a hitscan exchange */
+    float LastEngagedTime;
+
+    /** Cached line-of-sight result, re-traced at most every AdaptiveLOSRecheckTime */
+    bool bLineOfSightBlocked;
+    float LastLOSTraceTime;
+
+    /** This viewer's connection skips our updates until then (paced at DesiredRate) */
+    float NextReplicationTime;
+};
+
+/** One replicated movement update, stamped with the server time it was gathered at */
+struct FProxySnapshot
+{
+    FVector Location;
+    FRotator Rotation;
+    FVector Velocity;
+    float ServerTime;
+};
+
+/**
+ * Head sphere centre relative to the actor location at one saved-position time, kept in the
+ * actor's yaw frame together with that yaw so a rewind turns the head with the body.
+ * Quantized to 1/32 uu (+-1024 uu range) so the history stays ~12 bytes per sample.
+ */
+struct FSavedHeadOffset
+{
+    float Time;
+    int16 X;
+    int16 Y;
+    int16 Z;
+    uint16 Yaw;
+
+    static const float Scale;
+
+    void Set(float InTime, const FVector& LocalOffset, float InYaw)
+    {
+        Time = InTime;
+        X = (int16)FMath::Clamp(FMath::RoundToInt(LocalOffset.X * Scale), -32767, 32767);
+        Y = (int16)FMath::Clamp(FMath::RoundToInt(LocalOffset.Y * Scale), -32767, 32767);
+        Z = (int16)FMath::Clamp(FMath::RoundToInt(LocalOffset.Z * Scale), -32767, 32767);
+        Yaw = FRotator::CompressAxisToShort(InYaw);
+    }
+
+    FVector GetLocal() const { return FVector(X, Y, Z) / Scale; }
+    float GetYaw() const { return FRotator::DecompressAxisFromShort(Yaw); }
+};
+
 /**
  * Enhanced character that uses split prediction for movement.
  * 
@@ -50,6 +106,112 @@ public:
 
     virtual void PositionUpdated(bool bShotSpawned) override;
 
+    /**
+     * Server with PredictionTime > 0: rewound capsule location + the head offset recorded at that
+     * time (HeadOffsetHistory), so IsHeadShot tests the pose the shooter actually saw instead of
+     * the current animation. Otherwise stock behaviour.
+     */
+    virtual FVector GetHeadLocation(float PredictionTime = 0.f) override;
+
+    // Team collision roster events (see FTeamArenaCollisionRoster)
+    virtual void BeginPlay() override;
+    virtual void Destroyed() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void PossessedBy(AController* NewController) override;
+    virtual void OnRep_PlayerState() override;
+    virtual void NotifyTeamChanged() override;
+    virtual void PlayDying() override;
+    virtual void StartRagdoll() override;
+    virtual void StopRagdoll() override;
+
+    virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+    virtual bool IsReplicationPausedForConnection(const FNetViewer& ConnectionOwnerNetViewer) override;
+    virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+    // --- ADAPTIVE NET UPDATE FREQUENCY (server) ---
+
+    /**
+     * Called when Viewer's hitscan was aimed at us or ours at them.
+     * Snaps our rate for that viewer (and so NetUpdateFrequency) back to full immediately.
+     */
+    void NotifyHitScanEngagement(APlayerController* Viewer);
+
+    /** Scale update rate per viewer by distance, view cone, LOS and engagement. Off = fixed MaxAdaptiveNetUpdateFrequency. */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    bool bAdaptiveNetUpdateFrequency;
+
+    /** Rate for a pawn someone is looking at / fighting (Hz) */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float MaxAdaptiveNetUpdateFrequency;
+
+    /** Rate for a pawn nobody can see (Hz) */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float MinAdaptiveNetUpdateFrequency;
+
+    /** Full rate inside this distance of a viewer */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float AdaptiveNearDistance;
+
+    /** Distance term reaches zero here */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float AdaptiveFarDistance;
+
+    /** Cosine of the half-angle counted as "in view" */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float AdaptiveViewConeDot;
+
+    /** How long a hitscan exchange keeps the rate at full (seconds) */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float EngagementHoldTime;
+
+    /** How often per-viewer rates are re-evaluated (seconds) */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float AdaptiveRateUpdateInterval;
+
+    /** How long a viewer's line-of-sight trace result is reused (seconds) */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    float AdaptiveLOSRecheckTime;
+
+    /** Most LOS traces one pawn issues per rate update; viewers over budget keep their cached result */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Replication")
+    int32 MaxAdaptiveLOSTracesPerUpdate;
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    // --- SNAPSHOT INTERPOLATION (optional, np.ProxyInterpolation 1) ---
+
+    /** True if this simulated proxy is rendered from the snapshot buffer instead of snap + SmoothCorrection */
+    bool UsesSnapshotInterpolation() const;
+
+    /**
+     * Moves the proxy to its interpolated position at GetSnapshotRenderServerTime().
+     * Called by UTeamArenaCharacterMovement instead of simulating. Returns false if the buffer
+     * can't be used yet (caller falls back to normal simulation).
+     */
+    bool ApplySnapshotInterpolation(float DeltaTime);
+
+    /** Current interpolation delay (seconds) this proxy is rendered behind the newest server time */
+    float GetSnapshotRenderDelay() const { return SnapshotInterpDelay; }
+
+    /** Server time this proxy is currently drawn at */
+    float GetSnapshotRenderServerTime() const;
+
+    /** Smallest interpolation delay (seconds). One server update interval is the practical floor. */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Interpolation")
+    float MinSnapshotInterpDelay;
+
+    /** Largest interpolation delay (seconds) no matter how bad the jitter gets */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Interpolation")
+    float MaxSnapshotInterpDelay;
+
+    /** Delay = average snapshot interval + this many times the measured arrival jitter */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Interpolation")
+    float SnapshotJitterScale;
+
+    /** A snapshot further than this from where the previous one predicted is treated as a teleport (buffer reset) */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Interpolation")
+    float SnapshotTeleportDistance;
+
     /** Rate at which to save positions for lag compensation (Hz). Default 120. */
     UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
     float PositionSaveRate;
@@ -61,6 +223,41 @@ public:
     /** Calculated interval between position saves */
     float PositionSaveInterval;
 
+    /**
+     * Head offsets saved alongside SavedPositions (same cadence and age limit).
+     * Sampled from the mesh whenever its pose is up to date. A dedicated server doesn't tick the
+     * pose of unrendered meshes, so there it is forced every HeadPoseRefreshInterval and the last
+     * local offset is carried forward in between (the yaw is still fresh every sample).
+     */
+    TArray<FSavedHeadOffset> HeadOffsetHistory;
+
+    /** How often (seconds) the server forces a pose update for the head history when the mesh isn't ticking its pose */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
+    float HeadPoseRefreshInterval;
+
+    float LastHeadPoseRefreshTime;
+
+    /** History sizes last added to the NetcodePlus stat gauges */
+    int32 ReportedSavedPositions;
+    int32 ReportedHeadOffsets;
+
+    /** Records the current head offset into HeadOffsetHistory (called from PositionUpdated) */
+    void SaveHeadOffset(float WorldTime);
+
+    /** World-space head offset at TargetTime: the interpolated local offset turned by the rewound yaw. False if the history doesn't cover it. */
+    bool GetRewoundHeadOffset(float TargetTime, FVector& OutOffset) const;
+
+    /**
+     * Simulated proxies skip the EncroachingBlockingGeometry query when the new replicated location
+     * is within this distance of the last location the query found free.
+     */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
+    float EncroachCheckSkipDistance;
+
+    /** Corrections larger than this (teleports, respawns, big snaps) always run the full encroachment query */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
+    float EncroachCheckFullDistance;
+
 
 protected:
     /**
@@ -83,4 +280,48 @@ protected:
      * Prevents repeated casts every frame.
      */
     bool bHasCachedPC;
+
+    /** Last replicated location the full encroachment query found free (simulated proxies only) */
+    FVector LastVerifiedFreeLocation;
+    bool bHasVerifiedFreeLocation;
+
+    /** Cheap version of the bSimGravityDisabled check in UTUpdateSimulatedPosition */
+    bool IsSimulatedLocationEncroaching(const FVector& NewLocation, const FRotator& NewRotation);
+
+    /** Server: per-viewer rates, NetUpdateFrequency is the max of these and each connection is paced to its own */
+    TArray<FViewerNetRate> ViewerNetRates;
+    FTimerHandle AdaptiveNetRateHandle;
+
+    void UpdateAdaptiveNetRates();
+    /** Index into ViewerNetRates (entries are added, so don't hold references across calls) */
+    int32 FindOrAddViewerNetRate(APlayerController* Viewer);
+    void ApplyNetUpdateFrequency();
+
+    /** Server world time the current replicated movement was gathered at. Only sent to simulated proxies. */
+    UPROPERTY(Replicated)
+    float SnapshotServerTime;
+
+    /** Server: movement at the last stamp, so the timestamp only changes when the movement does */
+    FVector LastStampedLocation;
+    FRotator LastStampedRotation;
+    FVector LastStampedVelocity;
+
+    /** Client: ring of received snapshots, oldest at SnapshotHead */
+    enum { SnapshotBufferSize = 16 };
+    FProxySnapshot SnapshotBuffer[SnapshotBufferSize];
+    int32 SnapshotHead;
+    int32 SnapshotCount;
+
+    /** Client: smoothed (local time - server time) of snapshot arrivals, and its mean deviation (jitter) */
+    float SnapshotClockOffset;
+    float SnapshotArrivalJitter;
+
+    /** Client: smoothed server time between snapshots */
+    float SnapshotInterval;
+
+    /** Client: current adapted interpolation delay */
+    float SnapshotInterpDelay;
+
+    void AddSnapshot(const FVector& NewLocation, const FRotator& NewRotation, const FVector& NewVelocity);
+    const FProxySnapshot& GetSnapshot(int32 Index) const { return SnapshotBuffer[(SnapshotHead + Index) % SnapshotBufferSize]; }
 };
\ No newline at end of file
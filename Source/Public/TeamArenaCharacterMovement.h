@@ -1,6 +1,7 @@
 // TeamArenaCharacterMovement.h
 // High-FPS optimized movement component for UT4
 // Fixes: Team collision spam, position error tolerance, dodge timing tolerance
+// Team collision ignores are maintained by FTeamArenaCollisionRoster from character events
 
 #pragma once
 #include "NetcodePlus.h"
@@ -21,20 +22,129 @@ public:
 
     //~ Begin UUTCharacterMovement Interface
     virtual bool CanDodge() override;
+    virtual void SimulateMovement(float DeltaTime) override;
     //~ End UUTCharacterMovement Interface
 
-    /** How often to update team collision ignores (seconds). Default 0.25s */
+    //~ Begin UCharacterMovementComponent Interface
+    virtual float GetClientNetSendDeltaTime(const APlayerController* PC, const FNetworkPredictionData_Client_Character* ClientData, const FSavedMovePtr& NewMove) const override;
+    virtual bool CanDelaySendingMove(const FSavedMovePtr& NewMove) override;
+    virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+    //~ End UCharacterMovementComponent Interface
+
+    /**
+     * Client: a fire start/stop is about to be sent. Flushes any held move so the server processes
+     * our position before the fire RPC, and makes sure the next move isn't held either.
+     */
+    void NotifyFireBoundary();
+
+    /**
+     * The configured bForceTeamCollision. TickComponent sets the flag for the length of the parent
+     * tick to skip Epic's per-tick team loop; roster events raised inside that window use this.
+     */
+    bool IsTeamCollisionForced() const { return bInParentMovementTick ? bConfiguredForceTeamCollision : bForceTeamCollision; }
+
+    /**
+     * Upper bound on how often a client sends ServerMove (Hz).
+     * High-FPS clients combine moves up to this rate instead of flooding the server;
+     * jump, dodge and fire boundaries are always sent right away.
+     */
     UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
-    float TeamCollisionUpdateInterval;
+    float MaxServerMoveRate;
 
-    /** Tolerance added to dodge cooldown checks to prevent server rejection from timing jitter */
+    /**
+     * Tolerance added to dodge cooldown checks to prevent server rejection from timing jitter.
+     * With clock drift tracking this is the upper bound; the tolerance actually used shrinks
+     * with the measured drift (see GetDodgeCooldownTolerance).
+     */
     UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
     float DodgeCooldownTolerance;
 
+    /** Floor for the drift-based dodge tolerance (seconds) - covers float timestamp rounding */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
+    float MinDodgeCooldownTolerance;
+
+    /** Drift-based tolerance = |drift rate| * DodgeResetInterval + this many times the measured drift jitter */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Optimization")
+    float DodgeDriftJitterScale;
+
+    /** Measured client movement clock rate vs server clock, minus one (0 = same speed) */
+    UPROPERTY(VisibleInstanceOnly, Category = "Team Arena|Optimization")
+    float ClockDriftRate;
+
+    /** Measured unexplained timing error per drift window (seconds) */
+    UPROPERTY(VisibleInstanceOnly, Category = "Team Arena|Optimization")
+    float ClockDriftJitter;
+
+    /** Server: dodge cooldown slack for this connection right now */
+    float GetDodgeCooldownTolerance() const;
+
+    // --- ADAPTIVE POSITION ERROR TOLERANCE (server) ---
+
+    /** Scale MaxPositionErrorSquared from this connection's measured error instead of a fixed value */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Position Error")
+    bool bAdaptivePositionErrorTolerance;
+
+    /** Tolerance never goes below this (units). sqrt of the old fixed MaxPositionErrorSquared. */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Position Error")
+    float MinPositionErrorTolerance;
+
+    /** Tolerance never goes above this (units), whatever the stats say */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Position Error")
+    float MaxPositionErrorTolerance;
+
+    /** Tolerance = mean error + this many standard deviations (+ ping/velocity terms) */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Position Error")
+    float PositionErrorStdDevScale;
+
+    /** Extra units of tolerance per ms of ping */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Position Error")
+    float PositionErrorPingScale;
+
+    /** Extra units of tolerance per unit/sec of speed */
+    UPROPERTY(EditAnywhere, Category = "Team Arena|Position Error")
+    float PositionErrorVelocityScale;
+
+    /** Running mean of client vs server position error (units) */
+    UPROPERTY(VisibleInstanceOnly, Category = "Team Arena|Position Error")
+    float PositionErrorMean;
+
+    /** Running standard deviation of the error (units) */
+    UPROPERTY(VisibleInstanceOnly, Category = "Team Arena|Position Error")
+    float PositionErrorStdDev;
+
+    /** Tolerance used for the last check (units) */
+    UPROPERTY(VisibleInstanceOnly, Category = "Team Arena|Position Error")
+    float CurrentPositionErrorTolerance;
+
+    /** Moves checked / corrections sent for this connection */
+    UPROPERTY(VisibleInstanceOnly, Category = "Team Arena|Position Error")
+    int32 NumPositionChecks;
+
+    UPROPERTY(VisibleInstanceOnly, Category = "Team Arena|Position Error")
+    int32 NumPositionCorrections;
+
 protected:
-    /** Last time we updated team collision ignores */
-    float LastTeamCollisionUpdateTime;
+    /** TickComponent is inside Super::TickComponent with bForceTeamCollision overridden */
+    bool bInParentMovementTick;
+    bool bConfiguredForceTeamCollision;
+
+    /** bForceTeamCollision the roster last saw, so a runtime change triggers a refresh */
+    bool bRosterForceTeamCollision;
+
+    /** Server: start of the current drift measurement window (client timestamp / server time) */
+    float DriftWindowClientStart;
+    float DriftWindowServerStart;
+    int32 NumDriftWindows;
+
+    /** Feeds one client move timestamp into the drift estimate */
+    void UpdateClockDrift(float ClientTimeStamp);
+
+    /** Running variance behind PositionErrorStdDev */
+    float PositionErrorVariance;
+
+    /** Updates the error stats with one move and returns the tolerance for it */
+    float UpdatePositionErrorTolerance(float Error);
 
-    /** Performs the team collision ignore update (throttled) */
-    void UpdateTeamCollisionIgnores();
+    /** Set by NotifyFireBoundary, consumed by the next CanDelaySendingMove */
+    bool bFireBoundaryPending;
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+// TeamArenaCollisionRoster.h
+// Per-world roster that keeps teammate capsule ignores up to date from character events
+// (spawn, possession, team change, death, ragdoll, destroy) instead of polling every pawn.
+
+#pragma once
+#include "NetcodePlus.h"
+
+class AUTCharacter;
+class AUTGameState;
+
+class NETCODEPLUS_API FTeamArenaCollisionRoster
+{
+public:
+    /** Roster for this world (created on first use, released on world cleanup) */
+    static FTeamArenaCollisionRoster& Get(UWorld* World);
+
+    /** Existing roster for this world, or null. Never creates one (safe during teardown). */
+    static FTeamArenaCollisionRoster* Find(UWorld* World);
+
+    /** Hooked up by the module */
+    static void RegisterWorldDelegates();
+    static void UnregisterWorldDelegates();
+
+    /**
+     * Adds the character if needed and re-evaluates every pair it is part of.
+     * Call whenever something that changes team collision happens to it (spawn, possession,
+     * team change, death, ragdoll start/stop). Cost is O(N) for the one character.
+     */
+    void NotifyCharacterChanged(AUTCharacter* Char);
+
+    /** Removes the character and clears any ignores other members had on it */
+    void RemoveCharacter(AUTCharacter* Char);
+
+    /**
+     * Re-evaluates every pair. Used when an event was handled before the game state existed, or
+     * when a setting every pair depends on changed (bTeamCollision, a bForceTeamCollision).
+     */
+    void RefreshAll();
+
+    /** True if RefreshAll is due (checked from movement ticks) */
+    bool NeedsRefresh() const { return bNeedsRefresh; }
+
+    /** A character's bForceTeamCollision changed */
+    void MarkNeedsRefresh() { bNeedsRefresh = true; }
+
+    /** Marks for refresh if the game state's bTeamCollision changed since the last RefreshAll */
+    void CheckTeamCollisionSetting();
+
+private:
+    explicit FTeamArenaCollisionRoster(UWorld* InWorld) : World(InWorld), bNeedsRefresh(false), bRefreshedTeamCollision(false), bHasRefreshedTeamCollision(false) {}
+
+    /**
+     * Same rule Epic's per-tick loop used in UUTCharacterMovement, for Self's capsule only:
+     * Self ignores a live, non-ragdoll teammate unless Self's movement forces team collision.
+     */
+    static bool ShouldIgnore(const AUTGameState* GS, const AUTCharacter* Self, const AUTCharacter* Other);
+
+    /** Applies each direction for one pair from that side's own rule */
+    static void UpdatePair(const AUTGameState* GS, AUTCharacter* A, AUTCharacter* B);
+
+    static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    TWeakObjectPtr<UWorld> World;
+    TArray<TWeakObjectPtr<AUTCharacter>> Members;
+    bool bNeedsRefresh;
+
+    /** GS->bTeamCollision as of the last RefreshAll */
+    bool bRefreshedTeamCollision;
+    bool bHasRefreshedTeamCollision;
+
+    static TMap<TWeakObjectPtr<UWorld>, TSharedPtr<FTeamArenaCollisionRoster>> Rosters;
+    static FDelegateHandle WorldCleanupHandle;
+};
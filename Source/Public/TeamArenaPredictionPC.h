@@ -2,6 +2,7 @@
 #pragma once
 #include "NetcodePlus.h"
 #include "UTPlayerController.h"
+#include "NetcodePlusNetDiagnostics.h"
 #include "TeamArenaPredictionPC.generated.h"
 
 /**
@@ -42,6 +43,35 @@ public:
     //UFUNCTION(BlueprintCallable, Category = "Prediction")
     virtual float GetHitValidationTime() const;
 
+    virtual void PlayerTick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Wraps outgoing RPCs in FNetcodePlusRpcStats accounting */
+    virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, FFrame* Stack) override;
+
+    /**
+     * Server: interpolation delay (seconds) this client renders other players at, as reported by
+     * the client when np.ProxyInterpolation is on. 0 = not using snapshot interpolation.
+     */
+    float GetProxyInterpDelay() const { return ReportedProxyInterpDelay; }
+
+    /** Client tells the server how far behind the newest snapshot it draws other players */
+    UFUNCTION(Server, Reliable, WithValidation)
+    void ServerSetProxyInterpDelay(uint16 DelayMs);
+
+    /** Client toggled np.NetDiag: start/stop the server's diagnostics counters and pushes */
+    UFUNCTION(Server, Reliable, WithValidation)
+    void ServerSetNetDiagnosticsEnabled(bool bEnabled);
+
+    /** Server -> owning client: overlay stats, every NetDiagnosticsInterval while subscribed */
+    UFUNCTION(Client, Unreliable)
+    void ClientReceiveNetDiagnostics(FNetcodePlusNetDiagSnapshot Snapshot);
+
+    /** Server: the owner has the diagnostics overlay on (counters below are maintained) */
+    bool IsNetDiagnosticsSubscribed() const { return bNetDiagnosticsSubscribed; }
+
+    /** Server: rolling overlay counters while subscribed. Client: our own shots sent. */
+    FNetcodePlusNetDiagCounters NetDiagCounters;
 
 
 
@@ -84,4 +114,35 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Prediction")
     float PredictionSmoothingFactor_X;
 
+    /** Server copy of the client's proxy interpolation delay (seconds) */
+    float ReportedProxyInterpDelay;
+
+    /** Client: last delay sent and when, so we only report on change (max 2Hz) */
+    uint16 LastSentProxyInterpDelayMs;
+    float LastProxyInterpDelayReportTime;
+
+    /**
+     * Seconds between server pushes of the net diagnostics overlay stats.
+     * Clamped to 0.5-1.0 (1-2 Hz).
+     */
+    UPROPERTY(EditAnywhere, Category = "Prediction|Diagnostics")
+    float NetDiagnosticsInterval;
+
+    /** Server: owner asked for diagnostics */
+    bool bNetDiagnosticsSubscribed;
+    FTimerHandle NetDiagnosticsTimerHandle;
+
+    /** Client: overlay registered with the debug draw service */
+    bool bNetDiagnosticsOverlay;
+    FDelegateHandle NetDiagnosticsDrawHandle;
+    /** Client: lines formatted at the last push, drawn as-is every frame */
+    TArray<FString> NetDiagnosticsLines;
+    float LastNetDiagnosticsReceiveTime;
+
+    void SetNetDiagnosticsOverlay(bool bEnabled);
+    void SetNetDiagnosticsSubscribed(bool bEnabled);
+    /** Server: sample movement counters, build the snapshot and send it */
+    void PushNetDiagnostics();
+    void DrawNetDiagnostics(UCanvas* Canvas, APlayerController* PC);
+
 };
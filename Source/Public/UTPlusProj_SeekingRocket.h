@@ -0,0 +1,45 @@
+#pragma once
+#include "NetcodePlus.h"
+#include "UTProj_Rocket.h"
+#include "UTPlusProj_SeekingRocket.generated.h"
+
+class AUTPlusWeap_RocketLauncher;
+
+/**
+ * Seeking rocket for UTPlusWeap_RocketLauncher.
+ * Same homing as the stock seeking rocket, but while the launcher that fired it is alive the
+ * homing step is done by the launcher in one batched pass per target (UpdateTrackingRockets)
+ * instead of every rocket re-reading its target in its own Tick.
+ * If the launcher goes away (owner died, weapon dropped) the rocket falls back to stock self-homing.
+ * Stock rocket classes get the same batched step; the launcher parks their AdjustmentSpeed instead
+ * (see AUTPlusWeap_RocketLauncher::HandOffRocketHoming), this class just doesn't need that.
+ */
+UCLASS()
+class NETCODEPLUS_API AUTPlusProj_SeekingRocket : public AUTProj_Rocket
+{
+    GENERATED_BODY()
+
+public:
+    AUTPlusProj_SeekingRocket(const FObjectInitializer& ObjectInitializer);
+    virtual void Tick(float DeltaTime) override;
+
+    /**
+     * One homing step toward AimLocation. Same math as AUTProj_Rocket::Tick.
+     * Drops TargetActor once the rocket has passed it.
+     */
+    void ApplyHoming(const FVector& AimLocation, float DeltaTime);
+
+    /** The homing step itself, for any rocket, with the given AdjustmentSpeed. Clears TargetActor once passed. */
+    static void SteerRocket(AUTProj_Rocket* Rocket, const FVector& AimLocation, float InAdjustmentSpeed, float DeltaTime);
+
+    /** True if this rocket already got its homing step this frame (from the launcher or from itself) */
+    bool HasHomedThisFrame() const { return LastHomingFrame == GFrameCounter; }
+
+    /** Launcher doing our batched homing; we run its pass ourselves if its Tick didn't (server only) */
+    UPROPERTY()
+    TWeakObjectPtr<AUTPlusWeap_RocketLauncher> HomingLauncher;
+
+protected:
+    /** GFrameCounter of the last homing step, so a rocket never steers twice in one frame */
+    uint64 LastHomingFrame;
+};
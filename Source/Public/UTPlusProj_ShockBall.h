@@ -4,6 +4,17 @@
 #include "UTProj_ShockBall.h"
 #include "UTPlusProj_ShockBall.generated.h"
 
+/** One entry of the shock ball's lag compensation history (server only) */
+struct FShockBallSavedPosition
+{
+	FVector Position;
+	float Time;
+
+	FShockBallSavedPosition(const FVector& InPosition, float InTime)
+		: Position(InPosition), Time(InTime)
+	{}
+};
+
 /**
  * Custom shock ball projectile for UTPlusShockRifle.
  * Same as stock shock ball but references UTPlusShockRifle instead of UTWeap_ShockRifle.
@@ -17,6 +28,25 @@ public:
 	AUTPlusProj_ShockBall(const FObjectInitializer& ObjectInitializer);
 	virtual void Tick(float DeltaTime) override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Server only: where this ball was PredictionTime seconds ago.
+	 * Same interpolation as ATeamArenaCharacter::GetRewindLocation, so a combo beam is tested
+	 * against the ball the shooter actually saw.
+	 */
+	FVector GetRewindLocation(float PredictionTime) const;
+
+	/** Radius used when a rewound ball is tested against a hitscan beam */
+	float GetComboHitRadius() const;
+
+	/** How often the server records the ball position (Hz). Ball flight is linear, so this can be low. */
+	UPROPERTY(EditDefaultsOnly, Category = "Lag Compensation")
+	float PositionSaveRate;
+
+	/** How far back the position history goes (should cover MaxRewindMs on the weapon) */
+	UPROPERTY(EditDefaultsOnly, Category = "Lag Compensation")
+	float MaxSavedPositionAge;
 
 private:
 	// Forward declaration for safety
@@ -39,4 +69,10 @@ protected:
 	// Store the offset so the ball doesn't snap to the center of the actor
 	FVector InitialVisualOffset;
 	bool bVisualInitialized;
+
+	/** Server-side position history for rewinding combo hits. Oldest first. */
+	TArray<FShockBallSavedPosition> SavedPositions;
+	float LastPositionSaveTime;
+
+	void SavePosition();
 };
\ No newline at end of file
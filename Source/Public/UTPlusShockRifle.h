@@ -2,6 +2,7 @@
 #pragma once
 #include "NetcodePlus.h"
 #include "UTWeaponFix.h"
+#include "UTPlusWeaponScreenComponent.h"
 #include "UTPlusShockRifle.generated.h"
 
 #ifdef _MSC_VER
@@ -74,6 +75,10 @@ class NETCODEPLUS_API AUTPlusShockRifle : public AUTWeaponFix
 	UPROPERTY(BlueprintReadWrite, Category = Mesh)
 	UMaterialInstanceDynamic* ScreenMI;
 
+	/** only redraws ScreenTexture when ammo / kill-notify actually changed */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = Mesh)
+	UUTPlusWeaponScreenComponent* ScreenComponent;
+
 	/** anim to play for a shock combo instead of the normal one */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon")
 	UAnimMontage* ComboFireAnim;
@@ -104,6 +109,9 @@ class NETCODEPLUS_API AUTPlusShockRifle : public AUTWeaponFix
 	void Play1PComboEffects();
 
 	virtual void HitScanTrace(const FVector& StartLocation, const FVector& EndTrace, float TraceRadius, FHitResult& Hit, float PredictionTime) override;
+
+	/** Tests rewound AUTPlusProj_ShockBall positions against the beam so high ping combos register */
+	virtual void TraceRewoundProjectiles(const FVector& StartLocation, const FVector& EndTrace, float TraceRadius, FHitResult& Hit, float PredictionTime) override;
 	virtual AUTProjectile* FireProjectile() override;
 
 	/** returns whether AI using this weapon shouldn't fire because it's waiting for a combo trigger */
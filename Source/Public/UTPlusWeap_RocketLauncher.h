@@ -53,6 +53,17 @@ struct FPlusRocketFireMode
     }
 };
 
+/**
+ * A stock (non AUTPlusProj_SeekingRocket) rocket the launcher is steering.
+ * Its AdjustmentSpeed is parked here and zeroed on the server copy so AUTProj_Rocket::Tick
+ * doesn't steer it a second time; ReleaseRocketHoming puts it back.
+ */
+struct FHandedOffRocket
+{
+    TWeakObjectPtr<AUTProj_Rocket> Rocket;
+    float AdjustmentSpeed;
+};
+
 UCLASS(Abstract, Config = Game)
 class AUTPlusWeap_RocketLauncher : public AUTWeaponFix
 {
@@ -63,6 +74,7 @@ public:
 
     virtual void PostInitProperties() override;
     virtual void Destroyed() override;
+    virtual void Tick(float DeltaTime) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
     // === ROCKET LOADING ===
@@ -166,6 +178,7 @@ public:
     UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_PendingLockedTarget, Category = "Rocket Launcher")
     AActor* PendingLockedTarget;
 
+    /** Rocket fired with a lock. Any AUTProj_Rocket class gets the batched homing (see UpdateTrackingRockets). */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Rocket Launcher|Lock")
     TSubclassOf<AUTProjectile> SeekingRocketClass;
 
@@ -208,6 +221,20 @@ public:
     UPROPERTY()
     TArray<AUTProj_Rocket*> TrackingRockets;
 
+    /** Server: stock rockets in TrackingRockets whose homing we took over */
+    TArray<FHandedOffRocket> HandedOffRockets;
+
+    /**
+     * Seeking rockets aim at TargetLocation + TargetVelocity * (TimeToTarget * SeekingLeadScale).
+     * 0 = aim straight at the target like stock rockets.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Rocket Launcher|Lock")
+    float SeekingLeadScale;
+
+    /** Cap on the lead time used above (seconds) */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Rocket Launcher|Lock")
+    float SeekingMaxLeadTime;
+
     FTimerHandle UpdateLockHandle;
 
   
@@ -307,6 +334,20 @@ public:
     virtual void UpdateLock();
     virtual bool HasLockedTarget() const { return LockedTarget != nullptr && bLockedOnTarget; }
 
+    /**
+     * Server-side batched homing for TrackingRockets.
+     * Reads each target's location/velocity once per frame and steers every rocket locked on it,
+     * pruning dead/exploded rockets in the same pass. AUTPlusProj_SeekingRockets skip their own
+     * homing when steered; other rocket classes are handed off (HandOffRocketHoming) at spawn.
+     */
+    virtual void UpdateTrackingRockets(float DeltaTime);
+
+    /** Server: take over a stock rocket's homing (parks its AdjustmentSpeed) */
+    void HandOffRocketHoming(AUTProj_Rocket* Rocket);
+
+    /** Server: give a handed-off rocket its AdjustmentSpeed back and stop tracking the hand-off */
+    void ReleaseRocketHoming(AUTProj_Rocket* Rocket);
+
     UFUNCTION()
     void OnRep_LockedTarget();
 
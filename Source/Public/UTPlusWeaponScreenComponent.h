@@ -0,0 +1,56 @@
+// UTPlusWeaponScreenComponent.h
+// Drives a weapon's on-mesh canvas screen (link gun overheat, shock rifle ammo) and only
+// redraws it when what it displays actually changed.
+
+#pragma once
+#include "NetcodePlus.h"
+#include "Components/ActorComponent.h"
+#include "UTPlusWeaponScreenComponent.generated.h"
+
+class UCanvasRenderTarget2D;
+class UMaterialInstanceDynamic;
+class UPrimitiveComponent;
+
+UCLASS(ClassGroup = (NetcodePlus))
+class NETCODEPLUS_API UUTPlusWeaponScreenComponent : public UActorComponent
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+    /**
+     * Creates the render target, binds it to the screen material and remembers the mesh used
+     * for the visibility check. Owner binds OnCanvasRenderTargetUpdate to its draw function.
+     */
+    UCanvasRenderTarget2D* CreateScreenTexture(UPrimitiveComponent* InMesh, UMaterialInstanceDynamic* ScreenMI, int32 Width = 64, int32 Height = 64);
+
+    /**
+     * Feeds the values the screen currently shows. Marks the screen dirty if any differ from
+     * the last draw, then redraws only if dirty and the mesh was rendered recently
+     * (a dirty screen that is off-screen waits until it is seen again).
+     *
+     * @param DisplayValue - number drawn on the screen (ammo, overheat %), or any sentinel
+     * @param bKillNotify - kill-notify texture window is active
+     * @param ColorState - whatever colour bucket the owner draws with
+     */
+    void UpdateScreen(int32 DisplayValue, bool bKillNotify, uint8 ColorState);
+
+    /** Forces a redraw on the next visible UpdateScreen (e.g. new font / material) */
+    void MarkDirty() { bScreenDirty = true; }
+
+    /** Mesh counts as visible if rendered within this many seconds */
+    UPROPERTY(EditDefaultsOnly, Category = "Screen")
+    float VisibleRenderTime;
+
+protected:
+    UPROPERTY()
+    UCanvasRenderTarget2D* ScreenTexture;
+
+    UPROPERTY()
+    UPrimitiveComponent* ScreenMesh;
+
+    // Last drawn inputs
+    int32 LastDisplayValue;
+    bool bLastKillNotify;
+    uint8 LastColorState;
+    bool bScreenDirty;
+};
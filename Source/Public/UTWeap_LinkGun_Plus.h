@@ -4,6 +4,7 @@
 #include "UTWeaponFix.h"
 #include "Engine/Canvas.h"
 #include "Engine/CanvasRenderTarget2D.h"
+#include "UTPlusWeaponScreenComponent.h"
 #include "UTWeap_LinkGun_Plus.generated.h"
 
 class UUTWeaponStateFiringLinkBeamPlus;
@@ -13,6 +14,17 @@ class UAnimMontage;
 class UParticleSystem;
 class USoundBase;
 
+/** Segment the closed-form overheat curve is currently on */
+namespace ELinkOverheatSegment
+{
+    enum Type : uint8
+    {
+        Idle,       // decaying toward 0 after OverheatDecayDelay since last plasma shot
+        Heating,    // firing plasma, rising at OverheatHeatRate
+        Cooldown,   // crossed 1.0, locked out and falling at OverheatCooldownRate
+    };
+}
+
 UCLASS(abstract)
 class NETCODEPLUS_API AUTWeap_LinkGun_Plus : public AUTWeaponFix
 {
@@ -33,10 +45,6 @@ public:
     /** Called by beam state to process a client-side hit */
     void ProcessClientSideHit(float DeltaTime, AActor* HitActor, FVector HitLoc, const FInstantHitDamageInfo& DamageInfo);
 
-    /** Server RPC to validate and apply beam damage */
-    UFUNCTION(Server, WithValidation, Reliable)
-    void ServerProcessBeamHit(AActor* HitActor, FVector_NetQuantize HitLocation, int32 DamageAmount);
-
 
     // === Link Pull System ===
     UFUNCTION(Server, WithValidation, Reliable)
@@ -46,6 +54,30 @@ public:
     UFUNCTION(Server, Reliable, WithValidation)
     void ServerStopBeamFiring();
 
+    // ===========================================
+    // Beam Damage Stream
+    // ===========================================
+    // One "session" = one continuous beam on one target. The client sends its cumulative
+    // damage for the session unreliably with a sequence number; the server applies only
+    // the delta over what it already applied, so a lost packet is covered by the next one.
+    // Every delta is paid from one per-weapon damage budget refilled at beam DPS, so opening
+    // new sessions never buys extra damage.
+
+    /** Unreliable cumulative damage update for the current beam session */
+    UFUNCTION(Server, Unreliable, WithValidation)
+    void ServerBeamHitStream(uint8 SessionId, uint16 Sequence, AActor* HitActor, FVector_NetQuantize HitLocation, int32 CumulativeDamage);
+
+    /** Reliable final total when a session ends (target change, miss, beam stop) */
+    UFUNCTION(Server, Reliable, WithValidation)
+    void ServerEndBeamHitStream(uint8 SessionId, AActor* HitActor, FVector_NetQuantize HitLocation, int32 FinalDamage);
+
+    /** Client: flush the current session's final total and close it */
+    void EndBeamHitStream();
+
+    /** Seconds of beam DPS the server damage budget can bank (on top of one batch) to absorb jitter */
+    UPROPERTY(EditDefaultsOnly, Category = "NetcodePlus")
+    float BeamStreamTimeSlack;
+
     UPROPERTY()
     float LastBeamActivityTime;
 
@@ -77,6 +109,83 @@ public:
     /** Tracks if we're currently in high ping validation mode */
     bool bHighPingMode;
 
+protected:
+    // --- BEAM STREAM: client session state ---
+    uint8 BeamStreamSessionId;
+    uint16 BeamStreamSequence;
+    bool bBeamStreamOpen;
+    /** Exact (fractional) damage accumulated this session */
+    float BeamStreamDamage;
+    /** Whole damage already reported to the server this session */
+    int32 BeamStreamSentDamage;
+    TWeakObjectPtr<AActor> BeamStreamTarget;
+    FVector BeamStreamLastHitLoc;
+
+    // --- BEAM STREAM: server session state ---
+    uint8 ServerBeamSessionId;
+    uint16 ServerBeamSequence;
+    bool bServerBeamSessionOpen;
+    int32 ServerBeamAppliedDamage;
+    /** Previous session, kept until its reliable End arrives (it can trail the next session's updates) */
+    uint8 ServerBeamPrevSessionId;
+    bool bServerBeamPrevSessionOpen;
+    int32 ServerBeamPrevAppliedDamage;
+    /** Damage the beam may still deal, refilled at beam DPS up to GetBeamDamageBudgetCapacity() */
+    float ServerBeamDamageBudget;
+    float ServerBeamBudgetTime;
+
+    /**
+     * Server: shared handler for stream updates and session ends. Drops stale sessions/sequences
+     * and applies the delta over what the session already applied, paid from the damage budget.
+     * An End for the previous session is still settled against that session's applied total.
+     */
+    void HandleBeamHitStream(uint8 SessionId, uint16 Sequence, AActor* HitActor, const FVector& HitLocation, int32 CumulativeDamage, bool bFinal);
+
+    /** Server: refills the damage budget to Now and takes up to Requested from it; returns what was granted */
+    int32 ConsumeBeamDamageBudget(int32 Requested, float BeamDPS, float Now);
+
+    /** Most damage the budget can bank: one batch plus BeamStreamTimeSlack of beam DPS */
+    float GetBeamDamageBudgetCapacity(float BeamDPS) const;
+
+    /** Server: distance check + ValidateBeamHit, then deals one chunk of beam damage */
+    void ApplyBeamDamage(AActor* HitActor, const FVector& HitLocation, int32 DamageAmount);
+
+
+    // --- BEAM VALIDATION CACHE ---
+    struct FBeamValidationResult
+    {
+        TWeakObjectPtr<AActor> Target;
+        uint64 Frame;
+        float Time;
+        FVector BeamDir;
+        FVector FireStart;
+        bool bValid;
+
+        FBeamValidationResult() : Frame(0), Time(-1.f), BeamDir(FVector::ZeroVector), FireStart(FVector::ZeroVector), bValid(false) {}
+    };
+    FBeamValidationResult BeamValidationCache;
+
+    /**
+     * Server: wall check + (high ping) lenient rewind trace for a beam hit. The result is cached per
+     * target and server frame; a pass is also reused while fresh and the beam hasn't turned or moved.
+     */
+    bool ValidateBeamHit(AActor* HitActor, const FVector& FireStart, const FVector& HitLocation);
+
+public:
+    /** How long (seconds) a passed beam validation may be reused on later frames */
+    UPROPERTY(EditDefaultsOnly, Category = "NetcodePlus")
+    float BeamValidationCacheTime;
+
+    /** Max change in beam direction (degrees) for a cached validation to be reused */
+    UPROPERTY(EditDefaultsOnly, Category = "NetcodePlus")
+    float BeamValidationAngleTolerance;
+
+    /** Max movement of the fire start (uu) for a cached validation to be reused */
+    UPROPERTY(EditDefaultsOnly, Category = "NetcodePlus")
+    float BeamValidationMoveTolerance;
+
+public:
+
     // ===========================================
     // Link Gun Beam State
     // ===========================================
@@ -176,6 +285,63 @@ public:
     /** Last time plasma was fired (for overheat calc) */
     float LastFiredPlasmaTime;
 
+    /** Overheat gained per second while firing plasma */
+    UPROPERTY(EditDefaultsOnly, Category = "LinkGun|Overheat")
+    float OverheatHeatRate;
+
+    /** Overheat lost per second once idle */
+    UPROPERTY(EditDefaultsOnly, Category = "LinkGun|Overheat")
+    float OverheatDecayRate;
+
+    /** Seconds after the last plasma shot before idle decay starts */
+    UPROPERTY(EditDefaultsOnly, Category = "LinkGun|Overheat")
+    float OverheatDecayDelay;
+
+    /** Overheat lost per second during the overheat cooldown */
+    UPROPERTY(EditDefaultsOnly, Category = "LinkGun|Overheat")
+    float OverheatCooldownRate;
+
+    /** Overheat at the current time, evaluated from the anchored segment (no per-frame integration) */
+    float GetOverheatFactor() const;
+
+    /** True if the current time falls in an overheat cooldown segment */
+    bool IsOverheatCoolingDown() const;
+
+protected:
+    // --- CLOSED-FORM OVERHEAT ---
+    // Overheat is piecewise linear in time. We only store where the current segment started
+    // (value, time, segment) and whether the heating input was on; any query evaluates the
+    // curve analytically, so the result doesn't depend on frame rate or tick order.
+    // Times are on GetOverheatClock() (server world time) on both sides, so client and server
+    // run the same curve; they still anchor fire start/stop and plasma shots when each side sees
+    // them (plasma uses the stock fire RPCs, which carry no timestamp), so the two copies are
+    // offset by about the one-way latency rather than bit-identical.
+    ELinkOverheatSegment::Type OverheatAnchorSegment;
+    float OverheatAnchorValue;
+    float OverheatAnchorTime;
+    bool bOverheatAnchorHeating;
+
+    /** Ambient sound pitch bucket last applied (-1 = not applied) */
+    int32 OverheatPitchBucket;
+
+    /** Heating input: firing plasma at normal fire rate */
+    bool ShouldOverheatHeat() const;
+
+    /** Clock for the overheat curve and LastFiredPlasmaTime: server world time (client estimate off the server) */
+    float GetOverheatClock() const;
+
+    /** Walks the segments from the anchor to Now */
+    float EvaluateOverheat(float Now, ELinkOverheatSegment::Type& OutSegment) const;
+
+    /**
+     * Re-anchors on heating input changes (fire start/stop) and segment boundaries, mirrors
+     * the result into OverheatFactor / bIsInCoolDown and drives the overheat sound.
+     * Returns immediately when cold and not firing.
+     */
+    void RefreshOverheat();
+
+public:
+
     // ===========================================
     // Visual Effects
     // ===========================================
@@ -236,6 +402,10 @@ public:
     UPROPERTY()
     UCanvasRenderTarget2D* ScreenTexture;
 
+    /** Only redraws ScreenTexture when overheat / kill-notify display actually changed */
+    UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LinkGun|Screen")
+    UUTPlusWeaponScreenComponent* ScreenComponent;
+
     /** Font used on screen display */
     UPROPERTY(EditDefaultsOnly, Category = "LinkGun|Screen")
     UFont* ScreenFont;
@@ -6,6 +6,21 @@
 #include "UTWeapon.h"
 #include "UTWeaponFix.generated.h"
 
+/**
+ * Owning client: the trace FireShot ran to pick ClientHitChar for the RPC. FireInstantHit
+ * consumes it for the same shot, so the claimed hit and the local impact are one trace.
+ */
+struct FNetcodePlusClientPreTrace
+{
+    FVector SpawnLocation;
+    FRotator SpawnRotation;
+    FHitResult Hit;
+    uint8 FireMode;
+    bool bValid;
+
+    FNetcodePlusClientPreTrace() : SpawnLocation(ForceInit), SpawnRotation(ForceInit), FireMode(0), bValid(false) {}
+};
+
 /**
  * Enhanced weapon base class combining three critical fixes:
  * 
@@ -48,6 +63,8 @@ public:
     virtual void FireCone() override;
     virtual FVector GetFireStartLoc(uint8 FireMode = 255) override;
     virtual FRotator GetBaseFireRotation() override;
+    /** Wraps outgoing RPCs (all NetcodePlus weapons) in FNetcodePlusRpcStats accounting */
+    virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, FFrame* Stack) override;
     //virtual void BringUp(float OverflowTime) override;
     //~ End AUTWeapon Interface
     UPROPERTY()
@@ -72,6 +89,15 @@ protected:
     
     bool bHandlingRetry;
     FTimerHandle RetryFireHandle[2];
+
+    /** Set by FireShot around Super::FireShot() on the owning client, cleared after */
+    FNetcodePlusClientPreTrace ClientPreTrace;
+
+    /**
+     * FireInstantHit overrides: takes this shot's pre-trace if FireShot left one for the current
+     * fire mode. Returns false (and leaves the outputs alone) when the shot must trace itself.
+     */
+    bool ConsumeClientPreTrace(FVector& OutSpawnLocation, FRotator& OutSpawnRotation, FHitResult& OutHit);
     UPROPERTY(Transient)
     FRotator CachedTransactionalRotation;
 
@@ -207,4 +233,32 @@ protected:
 
     /** Impressive Add On */
     virtual void OnServerHitScanResult(const FHitResult& Hit, float PredictionTime);
+
+    /**
+     * Server-side hook called by HitScanTrace after the world trace and before the pawn checks.
+     * Lets weapons test lag-compensated projectiles (e.g. shock balls) at their rewound position
+     * and pull Hit in if one of them is closer. Default does nothing.
+     */
+    virtual void TraceRewoundProjectiles(const FVector& StartLocation, const FVector& EndTrace, float TraceRadius, FHitResult& Hit, float PredictionTime) {}
+
+    /**
+     * Distance from the shot segment to the skin of Target's capsule at its rewound position.
+     * <= 0 means the shot passed through the capsule.
+     */
+    float GetRewoundMissMargin(AUTCharacter* Target, const FVector& StartLocation, const FVector& EndTrace, float PredictionTime) const;
+
+    /**
+     * Server: writes this shot (client claim vs final Hit) to the audit log if np.AuditLog is on.
+     * Call after the headshot pass so Hit is the result that will deal damage.
+     */
+    void RecordHitAudit(const FHitResult& Hit, const FVector& StartLocation, const FVector& EndTrace, float PredictionTime, bool bHeadSphereHit);
+
+#if NETCODEPLUS_DIAGNOSTICS
+    /**
+     * np.HitDiag >= 1: fills Shot's diagnostics fields (rewind distance, nearest rewound pawn for
+     * unclaimed misses) and at level 2 logs rejected claims and near misses. Compiled out with
+     * NETCODEPLUS_DIAGNOSTICS 0.
+     */
+    void AddHitDiagnostics(AUTCharacter* DiagChar, const FVector& StartLocation, const FVector& EndTrace, float PredictionTime, int32 DiagLevel, struct FNPAuditShot& Shot) const;
+#endif
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "UTWeaponStateFiringLinkBeam.h"
 #include "UTWeaponStateFiringLinkBeamPlus.generated.h"
 
+class AUTWeap_LinkGun_Plus;
+
 UCLASS()
 class NETCODEPLUS_API UUTWeaponStateFiringLinkBeamPlus : public UUTWeaponStateFiringLinkBeam
 {
@@ -11,8 +13,6 @@ class NETCODEPLUS_API UUTWeaponStateFiringLinkBeamPlus : public UUTWeaponStateFi
 public:
 	virtual void Tick(float DeltaTime) override;
     virtual void BeginState(const UUTWeaponState* Prev) override;
-    // Accumulator for client-side damage batching
-    float ClientDamageAccumulator;
     virtual void RefireCheckTimer() override;
     bool bPendingEndFire;
     bool bPendingStartFire;
@@ -22,7 +22,42 @@ public:
     virtual void PendingFireStarted() override;
     virtual void EndState() override;
 	virtual void FireShot() override;
+
+    /**
+     * Rate (Hz) at which the beam is actually traced. Frames in between reuse the last sample
+     * and only interpolate the visual endpoint, so beam cost no longer scales with client FPS
+     * or server tick rate. 0 = trace every frame (old behaviour).
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "NetcodePlus")
+    float BeamTraceRate;
+
 protected:
     bool bHasBegun;
 
+    // --- FIXED-RATE BEAM: sample bookkeeping ---
+    /** Time banked toward the next beam trace */
+    float BeamTraceAccumulator;
+    /** True once the first trace of this firing sequence has run */
+    bool bHasBeamSample;
+    /** Endpoints of the previous and latest beam traces, for visual interpolation */
+    FVector PrevBeamEndpoint;
+    FVector LastBeamEndpoint;
+    /** bLinkCausingDamage from the latest sample, restored on frames that skip the trace */
+    bool bLastSampleCausingDamage;
+
+    /**
+     * Advances the trace accumulator. Returns true if a trace is due this frame, with
+     * OutStepTime set to the whole number of fixed steps it covers (exact damage time).
+     */
+    bool ConsumeBeamTraceStep(float DeltaTime, float& OutStepTime);
+
+    /** Endpoint lerped between the last two samples by how far we are into the next step */
+    FVector GetInterpolatedBeamEndpoint() const;
+
+    /** Records a new trace result as the latest sample */
+    void PushBeamSample(const FVector& Endpoint);
+
+    /** FireInstantHit without touching accuracy stats */
+    void TraceBeam(AUTWeap_LinkGun_Plus* LinkGun, FHitResult& Hit);
+
 };
\ No newline at end of file
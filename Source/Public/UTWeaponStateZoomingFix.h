@@ -2,6 +2,7 @@
 
 #include "NetcodePlus.h"
 #include "UTWeaponStateZooming.h"
+#include "WorldCollision.h"
 #include "UTWeaponStateZoomingFix.generated.h"
 
 UCLASS()
@@ -11,4 +12,28 @@ class NETCODEPLUS_API UUTWeaponStateZoomingFix : public UUTWeaponStateZooming
 
     // Override the HUD drawing to fix the Ping calculation
 	virtual bool DrawHUD(UUTHUDWidget* WeaponHudWidget) override;
+
+	/** Rate (Hz) at which head visibility is re-traced. Markers are still projected every frame. */
+	UPROPERTY(EditDefaultsOnly, Category = "Zoom")
+	float HeadTraceRate;
+
+protected:
+	/** Cached head visibility for one enemy, refreshed by async trace */
+	struct FZoomHeadVisibility
+	{
+		TWeakObjectPtr<AUTCharacter> Char;
+		FTraceHandle PendingTrace;
+		bool bVisible;
+	};
+	TArray<FZoomHeadVisibility> HeadVisibility;
+
+	/** Last time head traces were issued */
+	float LastHeadTraceTime;
+
+	FTraceDelegate HeadTraceDelegate;
+
+	FZoomHeadVisibility& FindOrAddHeadVisibility(AUTCharacter* EnemyChar);
+
+	/** Async trace completion: updates the matching cache entry */
+	void OnHeadTraceDone(const FTraceHandle& Handle, FTraceDatum& Data);
 };
\ No newline at end of file
@@ -0,0 +1,366 @@
+// NetcodePlusAuditAnalyzer.cpp
+// Offline reader for the server hit-registration audit log (*.npaudit, see
+// Source/Public/NetcodePlusAuditFormat.h). Aggregates rejection rate and miss-margin histograms
+// per weapon and ping bucket, to tune HitScanPadding / rewind against real matches.
+//
+// Build (Linux, no engine needed):
+//   g++ -std=c++11 -O2 -I../../Source/Public NetcodePlusAuditAnalyzer.cpp -o npaudit
+//
+// Usage:
+//   npaudit [--ping-bucket MS] [--include-bots] [--csv] file.npaudit [more.npaudit ...]
+
+#include "NetcodePlusAuditFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Miss-margin bins for rejected shots, in uu past the capsule skin
+    const float MarginEdges[] = { 0.f, 2.f, 5.f, 10.f, 20.f, 40.f, 80.f };
+    const int NumMarginBins = sizeof(MarginEdges) / sizeof(MarginEdges[0]) + 1;
+
+    struct FBucketStats
+    {
+        uint64_t Shots = 0;
+        uint64_t Claims = 0;
+        uint64_t Confirmed = 0;
+        uint64_t Rejected = 0;
+        uint64_t ServerOnly = 0;
+        uint64_t Headshots = 0;
+        double RewindMsSum = 0.0;
+        double TargetSpeedSum = 0.0;
+        uint64_t MarginBins[NumMarginBins] = {};
+        /** Rejected-shot margins, for percentiles */
+        std::vector<float> RejectedMargins;
+        /** np.HitDiag records only: unclaimed-miss margins to the nearest rewound pawn, rewind distances */
+        std::vector<float> NearMissMargins;
+        uint64_t DiagShots = 0;
+        double RewindDistanceSum = 0.0;
+    };
+
+    struct FOptions
+    {
+        int PingBucketMs = 40;
+        bool bIncludeBots = false;
+        bool bCsv = false;
+        std::vector<std::string> Files;
+    };
+
+    typedef std::pair<std::string, int> FKey;   // weapon name, ping bucket index
+
+    int MarginBin(float Margin)
+    {
+        if (Margin <= MarginEdges[0])
+        {
+            return 0;
+        }
+        for (int i = 1; i < NumMarginBins - 1; ++i)
+        {
+            if (Margin <= MarginEdges[i])
+            {
+                return i;
+            }
+        }
+        return NumMarginBins - 1;
+    }
+
+    std::string MarginBinLabel(int Bin)
+    {
+        char Buf[32];
+        if (Bin == 0)
+        {
+            std::snprintf(Buf, sizeof(Buf), "<=%g", MarginEdges[0]);
+        }
+        else if (Bin == NumMarginBins - 1)
+        {
+            std::snprintf(Buf, sizeof(Buf), ">%g", MarginEdges[NumMarginBins - 2]);
+        }
+        else
+        {
+            std::snprintf(Buf, sizeof(Buf), "%g-%g", MarginEdges[Bin - 1], MarginEdges[Bin]);
+        }
+        return Buf;
+    }
+
+    float Percentile(std::vector<float>& Values, float P)
+    {
+        if (Values.empty())
+        {
+            return 0.f;
+        }
+        const size_t Index = std::min(Values.size() - 1, (size_t)std::floor(P * (Values.size() - 1) + 0.5f));
+        std::nth_element(Values.begin(), Values.begin() + Index, Values.end());
+        return Values[Index];
+    }
+
+    bool ReadExact(FILE* File, void* Dest, size_t Bytes)
+    {
+        return std::fread(Dest, 1, Bytes, File) == Bytes;
+    }
+
+    /** @return false if the file isn't an audit log; truncated tails are tolerated (server crash / still writing) */
+    bool ReadFile(const std::string& Path, const FOptions& Options, std::map<FKey, FBucketStats>& Stats, uint64_t& OutShots)
+    {
+        FILE* File = std::fopen(Path.c_str(), "rb");
+        if (File == nullptr)
+        {
+            std::fprintf(stderr, "%s: cannot open\n", Path.c_str());
+            return false;
+        }
+
+        FNPAuditFileHeader Header;
+        std::memset(&Header, 0, sizeof(Header));
+        if (!ReadExact(File, &Header, sizeof(uint32_t) + 2 * sizeof(uint16_t)) || Header.Magic != NPAUDIT_MAGIC)
+        {
+            std::fprintf(stderr, "%s: not a NetcodePlus audit log\n", Path.c_str());
+            std::fclose(File);
+            return false;
+        }
+        if (Header.Version > NPAUDIT_VERSION)
+        {
+            std::fprintf(stderr, "%s: version %u is newer than this tool (%u)\n", Path.c_str(), Header.Version, NPAUDIT_VERSION);
+            std::fclose(File);
+            return false;
+        }
+        const size_t Rest = std::min<size_t>(Header.HeaderSize, sizeof(Header)) - (sizeof(uint32_t) + 2 * sizeof(uint16_t));
+        ReadExact(File, reinterpret_cast<char*>(&Header) + sizeof(uint32_t) + 2 * sizeof(uint16_t), Rest);
+        if (Header.HeaderSize > sizeof(Header))
+        {
+            std::fseek(File, Header.HeaderSize - sizeof(Header), SEEK_CUR);
+        }
+        Header.MapName[NPAUDIT_NAME_LEN - 1] = 0;
+
+        std::vector<std::string> WeaponNames(256, "Unknown");
+        uint64_t Shots = 0;
+        FNPAuditRecordHeader RecordHeader;
+        while (ReadExact(File, &RecordHeader, sizeof(RecordHeader)))
+        {
+            if (RecordHeader.Type == NPAuditRecord_WeaponName)
+            {
+                FNPAuditWeaponName Name;
+                std::memset(&Name, 0, sizeof(Name));
+                const size_t Bytes = std::min<size_t>(RecordHeader.Size, sizeof(Name));
+                if (!ReadExact(File, &Name, Bytes))
+                {
+                    break;
+                }
+                Name.Name[NPAUDIT_NAME_LEN - 1] = 0;
+                WeaponNames[Name.WeaponId] = Name.Name;
+                std::fseek(File, RecordHeader.Size - (long)Bytes, SEEK_CUR);
+            }
+            else if (RecordHeader.Type == NPAuditRecord_Shot)
+            {
+                FNPAuditShot Shot;
+                std::memset(&Shot, 0, sizeof(Shot));
+                const size_t Bytes = std::min<size_t>(RecordHeader.Size, sizeof(Shot));
+                if (!ReadExact(File, &Shot, Bytes))
+                {
+                    break;
+                }
+                std::fseek(File, RecordHeader.Size - (long)Bytes, SEEK_CUR);
+
+                if ((Shot.Flags & NPAuditFlag_Bot) && !Options.bIncludeBots)
+                {
+                    continue;
+                }
+                ++Shots;
+
+                FBucketStats& Bucket = Stats[FKey(WeaponNames[Shot.WeaponId], Shot.PingMs / Options.PingBucketMs)];
+                ++Bucket.Shots;
+                Bucket.RewindMsSum += Shot.RewindMs;
+                Bucket.TargetSpeedSum += Shot.TargetSpeed;
+                if (Shot.Flags & NPAuditFlag_Headshot)
+                {
+                    ++Bucket.Headshots;
+                }
+                if (Shot.Flags & NPAuditFlag_Diagnostics)
+                {
+                    ++Bucket.DiagShots;
+                    Bucket.RewindDistanceSum += Shot.RewindDistance;
+                    if (Shot.Result == NPAuditShot_Miss && Shot.NearMissMargin != NPAUDIT_NO_MARGIN)
+                    {
+                        Bucket.NearMissMargins.push_back(Shot.NearMissMargin);
+                    }
+                }
+                switch (Shot.Result)
+                {
+                case NPAuditShot_Confirmed:
+                    ++Bucket.Claims;
+                    ++Bucket.Confirmed;
+                    break;
+                case NPAuditShot_Rejected:
+                    ++Bucket.Claims;
+                    ++Bucket.Rejected;
+                    if (Shot.MissMargin != NPAUDIT_NO_MARGIN)
+                    {
+                        ++Bucket.MarginBins[MarginBin(Shot.MissMargin)];
+                        Bucket.RejectedMargins.push_back(Shot.MissMargin);
+                    }
+                    break;
+                case NPAuditShot_ServerOnly:
+                    ++Bucket.ServerOnly;
+                    break;
+                default:
+                    break;
+                }
+            }
+            else
+            {
+                std::fseek(File, RecordHeader.Size, SEEK_CUR);
+            }
+        }
+        std::fclose(File);
+
+        if (!Options.bCsv)
+        {
+            std::printf("%s: map %s, %llu shots\n", Path.c_str(), Header.MapName, (unsigned long long)Shots);
+        }
+        OutShots += Shots;
+        return true;
+    }
+
+    void PrintTable(std::map<FKey, FBucketStats>& Stats, const FOptions& Options)
+    {
+        if (Options.bCsv)
+        {
+            std::printf("weapon,ping_lo,ping_hi,shots,claims,confirmed,rejected,reject_rate,server_only,headshots,avg_rewind_ms,avg_target_speed,margin_p50,margin_p90,margin_p95");
+            for (int Bin = 0; Bin < NumMarginBins; ++Bin)
+            {
+                std::printf(",margin_%s", MarginBinLabel(Bin).c_str());
+            }
+            std::printf(",diag_shots,avg_rewind_dist,near_miss_p50,near_miss_p90\n");
+        }
+
+        std::string LastWeapon;
+        for (auto& Pair : Stats)
+        {
+            const std::string& Weapon = Pair.first.first;
+            const int PingLo = Pair.first.second * Options.PingBucketMs;
+            const int PingHi = PingLo + Options.PingBucketMs;
+            FBucketStats& B = Pair.second;
+            const double RejectRate = B.Claims ? double(B.Rejected) / B.Claims : 0.0;
+            const float P50 = Percentile(B.RejectedMargins, 0.50f);
+            const float P90 = Percentile(B.RejectedMargins, 0.90f);
+            const float P95 = Percentile(B.RejectedMargins, 0.95f);
+            const float NearP50 = Percentile(B.NearMissMargins, 0.50f);
+            const float NearP90 = Percentile(B.NearMissMargins, 0.90f);
+            const double AvgRewindDist = B.DiagShots ? B.RewindDistanceSum / B.DiagShots : 0.0;
+
+            if (Options.bCsv)
+            {
+                std::printf("%s,%d,%d,%llu,%llu,%llu,%llu,%.4f,%llu,%llu,%.1f,%.0f,%.2f,%.2f,%.2f",
+                    Weapon.c_str(), PingLo, PingHi, (unsigned long long)B.Shots, (unsigned long long)B.Claims,
+                    (unsigned long long)B.Confirmed, (unsigned long long)B.Rejected, RejectRate,
+                    (unsigned long long)B.ServerOnly, (unsigned long long)B.Headshots,
+                    B.Shots ? B.RewindMsSum / B.Shots : 0.0, B.Shots ? B.TargetSpeedSum / B.Shots : 0.0, P50, P90, P95);
+                for (int Bin = 0; Bin < NumMarginBins; ++Bin)
+                {
+                    std::printf(",%llu", (unsigned long long)B.MarginBins[Bin]);
+                }
+                std::printf(",%llu,%.1f,%.2f,%.2f\n", (unsigned long long)B.DiagShots, AvgRewindDist, NearP50, NearP90);
+                continue;
+            }
+
+            if (Weapon != LastWeapon)
+            {
+                std::printf("\n== %s ==\n", Weapon.c_str());
+                std::printf("  %-11s %7s %7s %7s %7s %7s %8s %8s\n", "ping ms", "shots", "claims", "reject", "rate", "srvonly", "rewind", "tgt spd");
+                LastWeapon = Weapon;
+            }
+            std::printf("  %4d-%-6d %7llu %7llu %7llu %6.2f%% %7llu %6.1fms %8.0f\n",
+                PingLo, PingHi, (unsigned long long)B.Shots, (unsigned long long)B.Claims, (unsigned long long)B.Rejected,
+                RejectRate * 100.0, (unsigned long long)B.ServerOnly,
+                B.Shots ? B.RewindMsSum / B.Shots : 0.0, B.Shots ? B.TargetSpeedSum / B.Shots : 0.0);
+
+            if (!B.RejectedMargins.empty())
+            {
+                // Margin is measured without padding, so p95 is roughly the padding that would have accepted 95% of these
+                std::printf("              miss margin p50 %.1f  p90 %.1f  p95 %.1f |", P50, P90, P95);
+                for (int Bin = 0; Bin < NumMarginBins; ++Bin)
+                {
+                    std::printf(" %s:%llu", MarginBinLabel(Bin).c_str(), (unsigned long long)B.MarginBins[Bin]);
+                }
+                std::printf("\n");
+            }
+            if (B.DiagShots)
+            {
+                // Server ran with np.HitDiag: how far unclaimed misses were from the nearest rewound pawn
+                std::printf("              hitdiag %llu shots  rewind dist %.1fuu |", (unsigned long long)B.DiagShots, AvgRewindDist);
+                if (!B.NearMissMargins.empty())
+                {
+                    std::printf(" near miss p50 %.1f  p90 %.1f (%llu)", NearP50, NearP90, (unsigned long long)B.NearMissMargins.size());
+                }
+                std::printf("\n");
+            }
+        }
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: npaudit [--ping-bucket MS] [--include-bots] [--csv] file.npaudit [...]\n"
+            "  --ping-bucket MS   ping bucket width (default 40)\n"
+            "  --include-bots     count shots fired by bots\n"
+            "  --csv              one CSV row per weapon/ping bucket\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FOptions Options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+        if (Arg == "--ping-bucket" && i + 1 < argc)
+        {
+            Options.PingBucketMs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (Arg == "--include-bots")
+        {
+            Options.bIncludeBots = true;
+        }
+        else if (Arg == "--csv")
+        {
+            Options.bCsv = true;
+        }
+        else if (Arg == "-h" || Arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+        {
+            Options.Files.push_back(Arg);
+        }
+    }
+    if (Options.Files.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::map<FKey, FBucketStats> Stats;
+    uint64_t TotalShots = 0;
+    int Failed = 0;
+    for (const std::string& Path : Options.Files)
+    {
+        if (!ReadFile(Path, Options, Stats, TotalShots))
+        {
+            ++Failed;
+        }
+    }
+
+    PrintTable(Stats, Options);
+    if (!Options.bCsv)
+    {
+        std::printf("\n%llu shots from %d file(s)\n", (unsigned long long)TotalShots, (int)Options.Files.size() - Failed);
+    }
+    return Failed == (int)Options.Files.size() ? 1 : 0;
+}
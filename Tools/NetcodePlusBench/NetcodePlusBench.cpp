@@ -0,0 +1,540 @@
+// NetcodePlusBench.cpp
+// Headless synthetic-load benchmark for server hit validation. Builds a world of N pawns with
+// 120 Hz saved-position histories from scripted motion (ADAD strafing, dodges with air time,
+// floor slides), fires M hitscan shots per second at them with rewinds across the usual ping
+// range, and runs each shot through the pawn pass of AUTWeaponFix::HitScanTrace using the same
+// NetcodePlusLagCompKernel.h rewind + capsule code the server runs.
+//
+// Pawns are laid out like the engine's: one heap object per pawn, the history in its own
+// allocation, capsule and movement state behind pointers. Only the pawn passes are measured, not
+// the motion simulation. Hardware counters come from perf_event_open and show as "n/a" where the
+// kernel or container doesn't allow them (see /proc/sys/kernel/perf_event_paranoid).
+//
+// Build (Linux, no engine needed):
+//   g++ -std=c++11 -O2 -I../../Source/Public NetcodePlusBench.cpp -o npbench
+//
+// Usage:
+//   npbench [--pawns 8,16,32,64,128] [--seconds 30] [--shots-per-sec 200] [--seed 1] [--csv]
+
+#include "NetcodePlusLagCompKernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using NetcodePlusLagComp::FNPVec3;
+
+namespace
+{
+    // Server defaults (ATeamArenaCharacter / AUTWeaponFix / UT capsule)
+    const float PositionSaveInterval = 1.f / 120.f;
+    const float MaxSavedPositionAge = 0.35f;
+    const float CapsuleRadius = 42.f;
+    const float CapsuleHalfHeight = 92.f;
+    const float SlideTargetHeight = 55.f;
+    const float HitScanPadding = 45.f;
+    const float HitScanPaddingStationary = 10.f;
+    /** Moves arrive at client frame rate; PositionUpdated throttles them to 120 Hz */
+    const float SimHz = 480.f;
+
+    /** Same footprint as FSavedPosition (position, view rotation, velocity, flags, two times) */
+    struct FBenchSavedPosition
+    {
+        FNPVec3 Position;
+        float Rotation[3];
+        FNPVec3 Velocity;
+        bool bTeleported;
+        bool bShotSpawned;
+        float Time;
+        float TimeStamp;
+    };
+
+    struct FBenchCapsule
+    {
+        float Radius;
+        float HalfHeight;
+        char ComponentPadding[504];
+    };
+
+    struct FBenchMovement
+    {
+        FNPVec3 Velocity;
+        bool bIsFloorSliding;
+        char ComponentPadding[496];
+    };
+
+    enum EMotion
+    {
+        Motion_Strafe,
+        Motion_Dodge,
+        Motion_Slide,
+    };
+
+    struct FBenchPawn
+    {
+        char ActorPadding[768];
+        FNPVec3 Location;
+        uint8_t TeamNum;
+        std::vector<FBenchSavedPosition> SavedPositions;
+        std::unique_ptr<FBenchCapsule> Capsule;
+        std::unique_ptr<FBenchMovement> Movement;
+
+        // motion script
+        EMotion Motion;
+        FNPVec3 Forward;
+        FNPVec3 Right;
+        float PhaseTime;
+        float Period;
+        float StrafeSign;
+        float AirVelocityZ;
+        float LastSaveTime;
+    };
+
+    struct FOptions
+    {
+        std::vector<int> PawnCounts = { 8, 16, 32, 64, 128 };
+        float Seconds = 30.f;
+        float ShotsPerSec = 200.f;
+        unsigned Seed = 1;
+        bool bCsv = false;
+    };
+
+    /** One hardware counter; Value() is -1 when unavailable */
+    class FPerfCounter
+    {
+    public:
+        FPerfCounter(uint32_t Type, uint64_t Config)
+        {
+            perf_event_attr Attr;
+            std::memset(&Attr, 0, sizeof(Attr));
+            Attr.size = sizeof(Attr);
+            Attr.type = Type;
+            Attr.config = Config;
+            Attr.disabled = 1;
+            Attr.exclude_kernel = 1;
+            Attr.exclude_hv = 1;
+            Fd = (int)syscall(__NR_perf_event_open, &Attr, 0, -1, -1, 0);
+        }
+        ~FPerfCounter()
+        {
+            if (Fd >= 0)
+            {
+                close(Fd);
+            }
+        }
+        void Reset() { if (Fd >= 0) { ioctl(Fd, PERF_EVENT_IOC_RESET, 0); } }
+        void Enable() { if (Fd >= 0) { ioctl(Fd, PERF_EVENT_IOC_ENABLE, 0); } }
+        void Disable() { if (Fd >= 0) { ioctl(Fd, PERF_EVENT_IOC_DISABLE, 0); } }
+        int64_t Value() const
+        {
+            uint64_t Count = 0;
+            if (Fd < 0 || read(Fd, &Count, sizeof(Count)) != sizeof(Count))
+            {
+                return -1;
+            }
+            return (int64_t)Count;
+        }
+
+    private:
+        int Fd;
+    };
+
+    struct FRunResult
+    {
+        int Pawns = 0;
+        uint64_t Shots = 0;
+        uint64_t Hits = 0;
+        uint64_t ClaimsConfirmed = 0;
+        uint64_t Claims = 0;
+        uint64_t Candidates = 0;
+        double PassNs = 0.0;
+        int64_t Cycles = -1;
+        int64_t Instructions = -1;
+        int64_t CacheReferences = -1;
+        int64_t CacheMisses = -1;
+        int64_t L1DMisses = -1;
+        double AvgHistory = 0.0;
+    };
+
+    FNPVec3 Normalize2D(const FNPVec3& V)
+    {
+        const float Len = std::sqrt(V.X * V.X + V.Y * V.Y);
+        return Len > 0.f ? FNPVec3(V.X / Len, V.Y / Len, 0.f) : FNPVec3(1.f, 0.f, 0.f);
+    }
+
+    /** Scripted movement: strafers reverse every 0.3-0.6 s, dodgers hop sideways with air time, sliders run low and fast */
+    void StepMotion(FBenchPawn& Pawn, float DeltaTime, std::mt19937& Rng)
+    {
+        std::uniform_real_distribution<float> Unit(0.f, 1.f);
+        FBenchMovement& Move = *Pawn.Movement;
+
+        Pawn.PhaseTime += DeltaTime;
+        if (Pawn.PhaseTime >= Pawn.Period)
+        {
+            Pawn.PhaseTime = 0.f;
+            Pawn.StrafeSign = -Pawn.StrafeSign;
+            switch (Pawn.Motion)
+            {
+            case Motion_Strafe:
+                Pawn.Period = 0.3f + 0.3f * Unit(Rng);
+                break;
+            case Motion_Dodge:
+                Pawn.Period = 0.6f + 0.6f * Unit(Rng);
+                Pawn.AirVelocityZ = 500.f;
+                break;
+            case Motion_Slide:
+                Pawn.Period = 0.8f + 0.8f * Unit(Rng);
+                Move.bIsFloorSliding = !Move.bIsFloorSliding;
+                break;
+            }
+        }
+
+        float LateralSpeed = 940.f;
+        float ForwardSpeed = 0.f;
+        if (Pawn.Motion == Motion_Dodge)
+        {
+            LateralSpeed = (Pawn.AirVelocityZ != 0.f || Pawn.Location.Z > 0.f) ? 1300.f : 600.f;
+        }
+        else if (Pawn.Motion == Motion_Slide)
+        {
+            LateralSpeed = 200.f;
+            ForwardSpeed = Move.bIsFloorSliding ? 1150.f : 700.f;
+        }
+
+        Move.Velocity = Pawn.Right * (LateralSpeed * Pawn.StrafeSign) + Pawn.Forward * ForwardSpeed;
+        if (Pawn.Motion == Motion_Dodge)
+        {
+            Pawn.AirVelocityZ -= 2100.f * DeltaTime;   // UT gravity incl. default GravityScale
+            Pawn.Location.Z = std::max(0.f, Pawn.Location.Z + Pawn.AirVelocityZ * DeltaTime);
+            if (Pawn.Location.Z <= 0.f)
+            {
+                Pawn.AirVelocityZ = 0.f;
+            }
+            Move.Velocity.Z = Pawn.AirVelocityZ;
+        }
+        Pawn.Location = Pawn.Location + FNPVec3(Move.Velocity.X, Move.Velocity.Y, 0.f) * DeltaTime;
+
+        // keep everyone inside a 4000uu arena so shots have crowds to pass through
+        const float Limit = 2000.f;
+        if (std::fabs(Pawn.Location.X) > Limit || std::fabs(Pawn.Location.Y) > Limit)
+        {
+            Pawn.Forward = Normalize2D(FNPVec3(-Pawn.Location.X, -Pawn.Location.Y, 0.f));
+            Pawn.Right = FNPVec3(-Pawn.Forward.Y, Pawn.Forward.X, 0.f);
+            Pawn.Location.X = std::max(-Limit, std::min(Limit, Pawn.Location.X));
+            Pawn.Location.Y = std::max(-Limit, std::min(Limit, Pawn.Location.Y));
+        }
+    }
+
+    /** ATeamArenaCharacter::PositionUpdated: 120 Hz samples, one kept past MaxSavedPositionAge */
+    void SavePosition(FBenchPawn& Pawn, float WorldTime)
+    {
+        if (WorldTime - Pawn.LastSaveTime < PositionSaveInterval)
+        {
+            return;
+        }
+        Pawn.LastSaveTime = WorldTime;
+
+        FBenchSavedPosition Saved = FBenchSavedPosition();
+        Saved.Position = Pawn.Location;
+        Saved.Velocity = Pawn.Movement->Velocity;
+        Saved.Time = WorldTime;
+        Saved.TimeStamp = WorldTime;
+        Pawn.SavedPositions.push_back(Saved);
+
+        if (NetcodePlusLagComp::ShouldTrimOldestSample((int32_t)Pawn.SavedPositions.size(), Pawn.SavedPositions.size() > 1 ? Pawn.SavedPositions[1].Time : 0.f, WorldTime, MaxSavedPositionAge))
+        {
+            Pawn.SavedPositions.erase(Pawn.SavedPositions.begin());
+        }
+    }
+
+    struct FShot
+    {
+        int Shooter;
+        int Claimed;
+        FNPVec3 Start;
+        FNPVec3 End;
+        float PredictionTime;
+    };
+
+    /** The pawn loop of AUTWeaponFix::HitScanTrace */
+    int RunPawnPass(const std::vector<FBenchPawn*>& Pawns, const FShot& Shot, float WorldTime, uint64_t& OutCandidates)
+    {
+        int BestTarget = -1;
+        FNPVec3 BestPoint;
+        const uint8_t ShooterTeam = Pawns[Shot.Shooter]->TeamNum;
+        for (int i = 0; i < (int)Pawns.size(); ++i)
+        {
+            const FBenchPawn* Target = Pawns[i];
+            if (i == Shot.Shooter || Target->TeamNum == ShooterTeam)
+            {
+                continue;
+            }
+            ++OutCandidates;
+
+            NetcodePlusLagComp::FCapsuleQuery Capsule;
+            Capsule.ExtraPadding = NetcodePlusLagComp::ClaimedTargetPadding(i == Shot.Claimed, Target->Movement->Velocity, HitScanPadding, HitScanPaddingStationary);
+            const FNPVec3 TargetLocation = NetcodePlusLagComp::RewindLocation(Target->SavedPositions.data(), (int32_t)Target->SavedPositions.size(), Target->Location, WorldTime - Shot.PredictionTime);
+            Capsule.HalfHeight = Target->Capsule->HalfHeight;
+            Capsule.Radius = Target->Capsule->Radius;
+            Capsule.bSliding = Target->Movement->bIsFloorSliding;
+            Capsule.SlideTargetHeight = SlideTargetHeight;
+
+            FNPVec3 ClosestPoint, ClosestCapsulePoint;
+            if (NetcodePlusLagComp::TraceHitsCapsule(Shot.Start, Shot.End, 0.f, TargetLocation, Capsule, ClosestPoint, ClosestCapsulePoint)
+                && (BestTarget < 0 || NetcodePlusLagComp::DistSquared(ClosestPoint, Shot.Start) < NetcodePlusLagComp::DistSquared(BestPoint, Shot.Start)))
+            {
+                BestTarget = i;
+                BestPoint = ClosestPoint;
+            }
+        }
+        return BestTarget;
+    }
+
+    FRunResult RunWorld(int NumPawns, const FOptions& Options)
+    {
+        std::mt19937 Rng(Options.Seed * 7919u + (unsigned)NumPawns);
+        std::uniform_real_distribution<float> Unit(0.f, 1.f);
+        std::normal_distribution<float> AimError(0.f, 30.f);
+
+        // Allocate pawns interleaved with unrelated garbage so they don't sit in one tidy block
+        std::vector<std::unique_ptr<FBenchPawn>> Owned;
+        std::vector<std::unique_ptr<char[]>> Garbage;
+        std::vector<FBenchPawn*> Pawns;
+        for (int i = 0; i < NumPawns; ++i)
+        {
+            Garbage.emplace_back(new char[1024 + (Rng() % 4096)]);
+            Owned.emplace_back(new FBenchPawn());
+            FBenchPawn& Pawn = *Owned.back();
+            Pawn.Location = FNPVec3(Unit(Rng) * 3000.f - 1500.f, Unit(Rng) * 3000.f - 1500.f, 0.f);
+            Pawn.TeamNum = (uint8_t)(i & 1);
+            Pawn.Capsule.reset(new FBenchCapsule());
+            Pawn.Capsule->Radius = CapsuleRadius;
+            Pawn.Capsule->HalfHeight = CapsuleHalfHeight;
+            Pawn.Movement.reset(new FBenchMovement());
+            Pawn.Movement->bIsFloorSliding = false;
+            Pawn.Motion = (EMotion)(i % 3);
+            Pawn.Forward = Normalize2D(FNPVec3(Unit(Rng) - 0.5f, Unit(Rng) - 0.5f, 0.f));
+            Pawn.Right = FNPVec3(-Pawn.Forward.Y, Pawn.Forward.X, 0.f);
+            Pawn.PhaseTime = 0.f;
+            Pawn.Period = 0.3f + 0.5f * Unit(Rng);
+            Pawn.StrafeSign = (Rng() & 1) ? 1.f : -1.f;
+            Pawn.AirVelocityZ = 0.f;
+            Pawn.LastSaveTime = -1.f;
+            Pawn.SavedPositions.reserve(64);
+            Pawns.push_back(&Pawn);
+        }
+
+        FPerfCounter Cycles(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        FPerfCounter Instructions(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        FPerfCounter CacheReferences(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES);
+        FPerfCounter CacheMisses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        FPerfCounter L1DMisses(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        FPerfCounter* Counters[] = { &Cycles, &Instructions, &CacheReferences, &CacheMisses, &L1DMisses };
+        for (FPerfCounter* Counter : Counters)
+        {
+            Counter->Reset();
+        }
+
+        FRunResult Result;
+        Result.Pawns = NumPawns;
+        const float DeltaTime = 1.f / SimHz;
+        const int Frames = (int)(Options.Seconds * SimHz);
+        // Let histories fill before shooting
+        const int WarmupFrames = (int)(MaxSavedPositionAge * SimHz) + 1;
+        float ShotBudget = 0.f;
+        uint64_t HistorySum = 0;
+        uint64_t HistorySamples = 0;
+        std::vector<FShot> FrameShots;
+
+        for (int Frame = 0; Frame < Frames + WarmupFrames; ++Frame)
+        {
+            const float WorldTime = Frame * DeltaTime;
+            for (FBenchPawn* Pawn : Pawns)
+            {
+                StepMotion(*Pawn, DeltaTime, Rng);
+                SavePosition(*Pawn, WorldTime);
+            }
+            if (Frame < WarmupFrames)
+            {
+                continue;
+            }
+
+            // Build this frame's shots outside the measured region: aim at where the shooter saw
+            // the target (its rewound position) with some error, claim it when the aim looked good
+            FrameShots.clear();
+            ShotBudget += Options.ShotsPerSec * DeltaTime;
+            while (ShotBudget >= 1.f)
+            {
+                ShotBudget -= 1.f;
+                FShot Shot;
+                Shot.Shooter = (int)(Rng() % NumPawns);
+                int Target = (int)(Rng() % NumPawns);
+                if (Pawns[Target]->TeamNum == Pawns[Shot.Shooter]->TeamNum)
+                {
+                    Target = (Target + 1) % NumPawns;
+                }
+                Shot.PredictionTime = 0.02f + 0.18f * Unit(Rng);
+                const FBenchPawn& TargetPawn = *Pawns[Target];
+                const FNPVec3 Seen = NetcodePlusLagComp::RewindLocation(TargetPawn.SavedPositions.data(), (int32_t)TargetPawn.SavedPositions.size(), TargetPawn.Location, WorldTime - Shot.PredictionTime);
+                const FNPVec3 Error(AimError(Rng), AimError(Rng), AimError(Rng));
+                Shot.Start = Pawns[Shot.Shooter]->Location + FNPVec3(0.f, 0.f, 64.f);
+                const FNPVec3 Aim = (Seen + Error) - Shot.Start;
+                const float AimLen = std::sqrt(NetcodePlusLagComp::Dot(Aim, Aim));
+                Shot.End = Shot.Start + Aim * (10000.f / std::max(AimLen, 1.f));
+                Shot.Claimed = (NetcodePlusLagComp::Dot(Error, Error) < 40.f * 40.f) ? Target : -1;
+                FrameShots.push_back(Shot);
+            }
+            if (FrameShots.empty())
+            {
+                continue;
+            }
+
+            for (FPerfCounter* Counter : Counters)
+            {
+                Counter->Enable();
+            }
+            const auto Start = std::chrono::steady_clock::now();
+            for (const FShot& Shot : FrameShots)
+            {
+                const int Hit = RunPawnPass(Pawns, Shot, WorldTime, Result.Candidates);
+                Result.Hits += (Hit >= 0);
+                Result.Claims += (Shot.Claimed >= 0);
+                Result.ClaimsConfirmed += (Shot.Claimed >= 0 && Hit == Shot.Claimed);
+            }
+            Result.PassNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count();
+            for (FPerfCounter* Counter : Counters)
+            {
+                Counter->Disable();
+            }
+            Result.Shots += FrameShots.size();
+
+            for (const FBenchPawn* Pawn : Pawns)
+            {
+                HistorySum += Pawn->SavedPositions.size();
+            }
+            HistorySamples += Pawns.size();
+        }
+
+        Result.Cycles = Cycles.Value();
+        Result.Instructions = Instructions.Value();
+        Result.CacheReferences = CacheReferences.Value();
+        Result.CacheMisses = CacheMisses.Value();
+        Result.L1DMisses = L1DMisses.Value();
+        Result.AvgHistory = HistorySamples ? double(HistorySum) / HistorySamples : 0.0;
+        return Result;
+    }
+
+    std::string PerShot(int64_t Value, uint64_t Shots, const char* Format)
+    {
+        if (Value < 0 || Shots == 0)
+        {
+            return "n/a";
+        }
+        char Buf[32];
+        std::snprintf(Buf, sizeof(Buf), Format, double(Value) / Shots);
+        return Buf;
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: npbench [--pawns 8,16,32,64,128] [--seconds 30] [--shots-per-sec 200] [--seed 1] [--csv]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FOptions Options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+        const bool bHasValue = i + 1 < argc;
+        if (Arg == "--pawns" && bHasValue)
+        {
+            Options.PawnCounts.clear();
+            std::stringstream List(argv[++i]);
+            std::string Item;
+            while (std::getline(List, Item, ','))
+            {
+                const int Count = std::atoi(Item.c_str());
+                if (Count >= 2)
+                {
+                    Options.PawnCounts.push_back(Count);
+                }
+            }
+        }
+        else if (Arg == "--seconds" && bHasValue)
+        {
+            Options.Seconds = std::max(1.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--shots-per-sec" && bHasValue)
+        {
+            Options.ShotsPerSec = std::max(1.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--seed" && bHasValue)
+        {
+            Options.Seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (Arg == "--csv")
+        {
+            Options.bCsv = true;
+        }
+        else
+        {
+            PrintUsage();
+            return (Arg == "-h" || Arg == "--help") ? 0 : 1;
+        }
+    }
+    if (Options.PawnCounts.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (Options.bCsv)
+    {
+        std::printf("pawns,shots,ns_per_shot,ns_per_candidate,hit_rate,claim_confirm_rate,avg_history,cycles_per_shot,instructions_per_shot,cache_refs_per_shot,cache_misses_per_shot,l1d_misses_per_shot\n");
+    }
+    else
+    {
+        std::printf("%.0f s simulated per run, %.0f shots/s, seed %u\n\n", Options.Seconds, Options.ShotsPerSec, Options.Seed);
+        std::printf("%6s %8s %9s %9s %6s %7s %7s %9s %9s %9s %9s %9s\n",
+            "pawns", "shots", "ns/shot", "ns/cand", "hit%", "claim%", "hist", "cyc/shot", "ins/shot", "ref/shot", "miss/shot", "l1d/shot");
+    }
+
+    for (int NumPawns : Options.PawnCounts)
+    {
+        const FRunResult R = RunWorld(NumPawns, Options);
+        const double NsPerShot = R.Shots ? R.PassNs / R.Shots : 0.0;
+        const double NsPerCandidate = R.Candidates ? R.PassNs / R.Candidates : 0.0;
+        const double HitRate = R.Shots ? 100.0 * R.Hits / R.Shots : 0.0;
+        const double ClaimRate = R.Claims ? 100.0 * R.ClaimsConfirmed / R.Claims : 0.0;
+        if (Options.bCsv)
+        {
+            std::printf("%d,%llu,%.2f,%.3f,%.2f,%.2f,%.1f,%s,%s,%s,%s,%s\n", R.Pawns, (unsigned long long)R.Shots, NsPerShot, NsPerCandidate, HitRate, ClaimRate, R.AvgHistory,
+                PerShot(R.Cycles, R.Shots, "%.1f").c_str(), PerShot(R.Instructions, R.Shots, "%.1f").c_str(),
+                PerShot(R.CacheReferences, R.Shots, "%.2f").c_str(), PerShot(R.CacheMisses, R.Shots, "%.3f").c_str(), PerShot(R.L1DMisses, R.Shots, "%.2f").c_str());
+        }
+        else
+        {
+            std::printf("%6d %8llu %9.1f %9.2f %6.1f %7.1f %7.1f %9s %9s %9s %9s %9s\n", R.Pawns, (unsigned long long)R.Shots, NsPerShot, NsPerCandidate, HitRate, ClaimRate, R.AvgHistory,
+                PerShot(R.Cycles, R.Shots, "%.0f").c_str(), PerShot(R.Instructions, R.Shots, "%.0f").c_str(),
+                PerShot(R.CacheReferences, R.Shots, "%.1f").c_str(), PerShot(R.CacheMisses, R.Shots, "%.2f").c_str(), PerShot(R.L1DMisses, R.Shots, "%.1f").c_str());
+        }
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,943 @@
+// NetcodePlusFireSim.cpp
+// Local network-impairment harness for the transactional fire pipeline. Runs a simulated owning
+// client and server of AUTWeaponFix over an in-process transport with configurable latency,
+// jitter, loss and reordering, drives scripted fire patterns at several client frame rates, and
+// checks shots fired vs accepted, ClientConfirmFireEvent resyncs and time-to-first-shot. No
+// engine, no sockets: everything runs on one simulated clock and is deterministic per seed.
+//
+// The gates (event index window, client/server refire tolerances, timestamp sanity, rhythm
+// compensation, retry wait) come from NetcodePlusFireSequenceKernel.h, the header the weapon
+// itself calls. The glue around them mirrors the plugin:
+//   client  StartFire (cooldown -> retry timer, mode lock), UUTWeaponStateFiring_Transactional
+//           (looping RefireCheckTimer, stop on release), FireShot (next index, LastFireTime,
+//           ServerStartFireFixed with the estimated server time), ClientConfirmFireEvent
+//   server  ValidateFireRequest + ServerStartFireFixed; a rejection answers with
+//           ClientConfirmFireEvent(Authoritative index)
+//   frame   net receive -> input -> timer manager -> net send. Timers set from input use the
+//           timer manager's time from the previous frame, as FTimerManager does; looping timers
+//           keep their phase and catch up with multiple calls.
+//   link    packets per frame/tick; the RPCs are Reliable, so loss costs a NAK round trip and
+//           an early packet waits for its predecessors (head-of-line). --unreliable delivers
+//           RPCs as they arrive and drops lost ones, to stress the sequence/resync path.
+//
+// Build (Linux, no engine needed):
+//   g++ -std=c++11 -O2 -I../../Source/Public NetcodePlusFireSim.cpp -o npfiresim
+//
+// Usage:
+//   npfiresim [--fps 60,144,240,480] [--patterns hold,tap,switch,mixed] [--seconds 60]
+//             [--latency-ms 40] [--jitter-ms 10] [--loss 0] [--reorder 0] [--reorder-ms 15]
+//             [--clock-error-ms 0] [--server-hz 120] [--refire 0.6,0.35] [--unreliable]
+//             [--min-accept 100] [--max-rewinds 0] [--max-ttfs-ms <frame + retry padding>]
+//             [--seed 1] [--csv] [--verbose]
+// Exit code is 1 if any scenario fails its assertions: accepted share of the shots that reached
+// the server (--min-accept, %), confirms that rewound the client's event index (--max-rewinds) and
+// worst time to first shot, measured from the later of press and weapon-ready to the RPC leaving
+// the client. The defaults (a clean 40 ms + 10 ms jitter link) are the gate; add --loss /
+// --reorder / --unreliable to look at how the pipeline degrades.
+
+#include "NetcodePlusFireSequenceKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace NPFS = NetcodePlusFireSequence;
+
+namespace
+{
+    /** World time when the match starts; keeps LastFireTime > 0 meaningful like a real level */
+    const double StartTime = 5.0;
+    const int NumModes = 2;
+
+    struct FOptions
+    {
+        std::vector<int> FrameRates;
+        std::vector<std::string> Patterns;
+        float Seconds = 60.f;
+        float LatencyMs = 40.f;
+        float JitterMs = 10.f;
+        float LossPct = 0.f;
+        float ReorderPct = 0.f;
+        float ReorderMs = 15.f;
+        float ClockErrorMs = 0.f;
+        float ServerHz = 120.f;
+        float Refire[NumModes] = { 0.6f, 0.35f };
+        bool bUnreliable = false;
+        float MinAcceptPct = 100.f;
+        int MaxRewinds = 0;
+        /** < 0: one client frame plus the kernel's retry padding */
+        float MaxTtfsMs = -1.f;
+        unsigned Seed = 1;
+        bool bCsv = false;
+        bool bVerbose = false;
+    };
+
+    // ---------------------------------------------------------------
+    // TRANSPORT
+    // ---------------------------------------------------------------
+
+    enum EMessageType
+    {
+        Msg_ServerStartFire,
+        Msg_ClientConfirm,
+    };
+
+    struct FMessage
+    {
+        EMessageType Type;
+        uint8_t FireMode;
+        int32_t EventIndex;
+        float ClientTimestamp;
+        /** Press that caused the shot, for latency bookkeeping (-1 = none) */
+        int PressId;
+    };
+
+    struct FPacket
+    {
+        double Arrival;
+        uint32_t Seq;
+        std::vector<FMessage> Messages;
+    };
+
+    /** One direction of the connection */
+    class FSimLink
+    {
+    public:
+        uint64_t PacketsSent = 0;
+        uint64_t Transmissions = 0;
+        uint64_t PacketsLost = 0;
+        uint64_t PacketsOutOfOrder = 0;
+        /** Messages that never arrive (--unreliable only) */
+        uint64_t MessagesDropped = 0;
+
+        FSimLink(const FOptions& InOptions, double InReceiverTick, std::mt19937& InRng)
+            : Options(InOptions), ReceiverTick(InReceiverTick), Rng(InRng)
+        {
+        }
+
+        void Send(double Now, std::vector<FMessage>& Messages)
+        {
+            if (Messages.empty())
+            {
+                return;
+            }
+            FPacket Packet;
+            Packet.Seq = NextSeq++;
+            Packet.Messages.swap(Messages);
+            PacketsSent++;
+
+            const double Latency = Options.LatencyMs * 0.001;
+            double SendTime = Now;
+            for (;;)
+            {
+                Transmissions++;
+                if (!Roll(Options.LossPct))
+                {
+                    break;
+                }
+                PacketsLost++;
+                if (Options.bUnreliable)
+                {
+                    MessagesDropped += Packet.Messages.size();
+                    return;
+                }
+                // Resent once the NAK comes back: a round trip plus the receiver's tick
+                SendTime += 2.0 * Latency + Jitter() + ReceiverTick;
+            }
+            Packet.Arrival = SendTime + Latency + Jitter() + (Roll(Options.ReorderPct) ? Options.ReorderMs * 0.001 : 0.0);
+            InFlight.push_back(std::move(Packet));
+        }
+
+        void Receive(double Now, std::vector<FMessage>& Out)
+        {
+            std::vector<FPacket> Arrived;
+            for (size_t i = 0; i < InFlight.size();)
+            {
+                if (InFlight[i].Arrival <= Now)
+                {
+                    Arrived.push_back(std::move(InFlight[i]));
+                    InFlight[i] = std::move(InFlight.back());
+                    InFlight.pop_back();
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            std::sort(Arrived.begin(), Arrived.end(), [](const FPacket& A, const FPacket& B) { return A.Arrival < B.Arrival; });
+
+            for (FPacket& Packet : Arrived)
+            {
+                if (Packet.Seq != NextExpected)
+                {
+                    PacketsOutOfOrder += (Packet.Seq > NextExpected || Options.bUnreliable) ? 1 : 0;
+                }
+                if (Options.bUnreliable)
+                {
+                    NextExpected = std::max(NextExpected, Packet.Seq + 1);
+                    Out.insert(Out.end(), Packet.Messages.begin(), Packet.Messages.end());
+                    continue;
+                }
+                // Reliable: hold until every earlier packet is in
+                Held[Packet.Seq] = std::move(Packet);
+                for (auto It = Held.find(NextExpected); It != Held.end(); It = Held.find(NextExpected))
+                {
+                    Out.insert(Out.end(), It->second.Messages.begin(), It->second.Messages.end());
+                    Held.erase(It);
+                    NextExpected++;
+                }
+            }
+        }
+
+    private:
+        const FOptions& Options;
+        double ReceiverTick;
+        std::mt19937& Rng;
+        std::vector<FPacket> InFlight;
+        std::map<uint32_t, FPacket> Held;
+        uint32_t NextSeq = 0;
+        uint32_t NextExpected = 0;
+
+        bool Roll(float Pct)
+        {
+            return Pct > 0.f && std::uniform_real_distribution<float>(0.f, 100.f)(Rng) < Pct;
+        }
+
+        double Jitter()
+        {
+            return Options.JitterMs > 0.f ? std::uniform_real_distribution<double>(0.0, Options.JitterMs * 0.001)(Rng) : 0.0;
+        }
+    };
+
+    // ---------------------------------------------------------------
+    // INPUT SCRIPTS
+    // ---------------------------------------------------------------
+
+    struct FInputEvent
+    {
+        double Time;
+        uint8_t FireMode;
+        bool bPress;
+    };
+
+    void AddClick(std::vector<FInputEvent>& Events, double Time, uint8_t Mode, double Hold)
+    {
+        Events.push_back({ Time, Mode, true });
+        Events.push_back({ Time + Hold, Mode, false });
+    }
+
+    bool BuildPattern(const std::string& Name, const FOptions& Options, std::mt19937& Rng, std::vector<FInputEvent>& Events)
+    {
+        const double End = StartTime + Options.Seconds;
+        const double R0 = Options.Refire[0];
+        double T = StartTime + 0.5;
+        if (Name == "hold")
+        {
+            // Hold primary for a few refires, short pause, repeat
+            for (; T < End; T += 2.5 + 0.8)
+            {
+                AddClick(Events, T, 0, 2.5);
+            }
+        }
+        else if (Name == "tap")
+        {
+            // Click spam faster than the refire rate; most clicks land on cooldown
+            for (; T < End; T += 0.75 * R0)
+            {
+                AddClick(Events, T, 0, 0.04);
+            }
+        }
+        else if (Name == "switch")
+        {
+            // Primary burst, then straight into alt fire: exercises the global cooldown + retry
+            for (; T < End; T += 1.0 + 0.02 + 1.0 + 0.5)
+            {
+                AddClick(Events, T, 0, 1.0);
+                AddClick(Events, T + 1.02, 1, 1.0);
+            }
+        }
+        else if (Name == "mixed")
+        {
+            std::uniform_real_distribution<double> HoldDist(0.05, 1.5);
+            std::uniform_real_distribution<double> GapDist(0.03, 0.6);
+            std::uniform_real_distribution<float> ModeDist(0.f, 1.f);
+            while (T < End)
+            {
+                const double Hold = HoldDist(Rng);
+                AddClick(Events, T, ModeDist(Rng) < 0.8f ? 0 : 1, Hold);
+                T += Hold + GapDist(Rng);
+            }
+        }
+        else
+        {
+            return false;
+        }
+        std::stable_sort(Events.begin(), Events.end(), [](const FInputEvent& A, const FInputEvent& B) { return A.Time < B.Time; });
+        return true;
+    }
+
+    // ---------------------------------------------------------------
+    // CLIENT / SERVER
+    // ---------------------------------------------------------------
+
+    struct FPress
+    {
+        double Time;
+        /** Client weapon ready time when the press was handled */
+        double ReadyTime;
+        double FirstShotSent = -1.0;
+        double FirstShotAccepted = -1.0;
+    };
+
+    struct FScenarioStats
+    {
+        uint64_t ShotsFired = 0;
+        uint64_t ShotsAccepted = 0;
+        uint64_t RejectSequence = 0;
+        uint64_t RejectDesync = 0;
+        uint64_t RejectRefire = 0;
+        uint64_t ConfirmsReceived = 0;
+        /** Confirms that moved the client's event index backwards (in-flight shots will be re-used) */
+        uint64_t IndexRewinds = 0;
+        /** Presses released before they produced a shot */
+        uint64_t DroppedPresses = 0;
+        std::vector<FPress> Presses;
+    };
+
+    /** FTimerManager subset: timers set during the frame count from the last Tick's time */
+    struct FSimTimer
+    {
+        bool bActive = false;
+        bool bLoop = false;
+        double Rate = 0.0;
+        double Expire = 0.0;
+    };
+
+    class FSimClient
+    {
+    public:
+        std::vector<FMessage> Outgoing;
+
+        FSimClient(const FOptions& InOptions, FScenarioStats& InStats) : Options(InOptions), Stats(InStats)
+        {
+        }
+
+        void ReceiveConfirm(const FMessage& Message)
+        {
+            // ClientConfirmFireEvent_Implementation
+            Stats.ConfirmsReceived++;
+            if (Message.EventIndex < ClientFireEventIndex[Message.FireMode])
+            {
+                Stats.IndexRewinds++;
+            }
+            ClientFireEventIndex[Message.FireMode] = Message.EventIndex;
+        }
+
+        void InputPress(double Now, double TrueTime, uint8_t Mode)
+        {
+            PendingFire[Mode] = true;
+            FPress Press;
+            Press.Time = TrueTime;
+            Press.ReadyTime = std::max(TrueTime, (double)MaxReadyTime());
+            CurrentPress[Mode] = (int)Stats.Presses.size();
+            Stats.Presses.push_back(Press);
+            StartFire(Now, Mode);
+        }
+
+        void InputRelease(uint8_t Mode)
+        {
+            PendingFire[Mode] = false;
+            if (CurrentPress[Mode] >= 0 && Stats.Presses[CurrentPress[Mode]].FirstShotSent < 0.0)
+            {
+                Stats.DroppedPresses++;
+            }
+            CurrentPress[Mode] = -1;
+            StopFire(Mode);
+        }
+
+        void TickTimers(double Now)
+        {
+            TimerTime = Now;
+            for (;;)
+            {
+                FSimTimer* Next = nullptr;
+                int NextId = -1;
+                for (int i = 0; i < 1 + NumModes; i++)
+                {
+                    FSimTimer& Timer = i == 0 ? RefireCheck : Retry[i - 1];
+                    if (Timer.bActive && Timer.Expire <= TimerTime && (!Next || Timer.Expire < Next->Expire))
+                    {
+                        Next = &Timer;
+                        NextId = i;
+                    }
+                }
+                if (!Next)
+                {
+                    break;
+                }
+                if (NextId == 0)
+                {
+                    const int CallCount = (int)std::floor((TimerTime - RefireCheck.Expire) / RefireCheck.Rate) + 1;
+                    RefireCheck.Expire += CallCount * RefireCheck.Rate;
+                    for (int Call = 0; Call < CallCount && RefireCheck.bActive; Call++)
+                    {
+                        RefireCheckTimer(Now);
+                    }
+                }
+                else
+                {
+                    Next->bActive = false;
+                    StartFire(Now, (uint8_t)(NextId - 1)); // OnRetryTimer
+                }
+            }
+        }
+
+    private:
+        const FOptions& Options;
+        FScenarioStats& Stats;
+        float LastFireTime[NumModes] = { -1.f, -1.f };
+        int32_t ClientFireEventIndex[NumModes] = { 0, 0 };
+        bool PendingFire[NumModes] = { false, false };
+        int CurrentPress[NumModes] = { -1, -1 };
+        /** Mode of the transactional firing state, -1 = active state */
+        int FiringMode = -1;
+        FSimTimer RefireCheck;
+        FSimTimer Retry[NumModes];
+        double TimerTime = StartTime;
+
+        void SetTimer(FSimTimer& Timer, double Rate, bool bLoop)
+        {
+            Timer.bActive = true;
+            Timer.bLoop = bLoop;
+            Timer.Rate = Rate;
+            Timer.Expire = TimerTime + Rate;
+        }
+
+        float MaxReadyTime() const
+        {
+            float ReadyTime = 0.f;
+            for (int i = 0; i < NumModes; i++)
+            {
+                if (LastFireTime[i] > 0.f)
+                {
+                    ReadyTime = std::max(ReadyTime, LastFireTime[i] + Options.Refire[i]);
+                }
+            }
+            return ReadyTime;
+        }
+
+        bool IsFireModeOnCooldown(float Now) const
+        {
+            for (int i = 0; i < NumModes; i++)
+            {
+                if (NPFS::IsModeRecovering(LastFireTime[i], Options.Refire[i], Now, NPFS::ClientRefireTolerance))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void StartFire(double Now, uint8_t Mode)
+        {
+            if (IsFireModeOnCooldown((float)Now))
+            {
+                if (FiringMode == Mode)
+                {
+                    Retry[Mode].bActive = false;
+                    return;
+                }
+                SetTimer(Retry[Mode], NPFS::RetryDelay(MaxReadyTime(), (float)Now), false);
+                return;
+            }
+            Retry[Mode].bActive = false;
+
+            // Mode lock and re-entry
+            if (FiringMode >= 0)
+            {
+                return;
+            }
+
+            // BeginFiringSequence -> UUTWeaponStateFiring_Transactional::BeginState
+            FiringMode = Mode;
+            SetTimer(RefireCheck, Options.Refire[Mode], true);
+            FireShot(Now);
+        }
+
+        void StopFire(uint8_t Mode)
+        {
+            Retry[Mode].bActive = false;
+            if (FiringMode == Mode)
+            {
+                // GotoActiveState -> EndState clears the refire timer
+                RefireCheck.bActive = false;
+                FiringMode = -1;
+            }
+        }
+
+        void RefireCheckTimer(double Now)
+        {
+            // HandleContinuedFiring: still holding the button?
+            if (FiringMode >= 0 && PendingFire[FiringMode])
+            {
+                FireShot(Now);
+            }
+            else if (FiringMode >= 0)
+            {
+                StopFire((uint8_t)FiringMode);
+            }
+        }
+
+        void FireShot(double Now)
+        {
+            const uint8_t Mode = (uint8_t)FiringMode;
+            const int32_t NextEventIndex = ClientFireEventIndex[Mode] + 1;
+            ClientFireEventIndex[Mode] = NextEventIndex;
+            LastFireTime[Mode] = (float)Now;
+
+            // GetServerWorldTimeSeconds lags the server by roughly the one-way latency
+            FMessage Message;
+            Message.Type = Msg_ServerStartFire;
+            Message.FireMode = Mode;
+            Message.EventIndex = NextEventIndex;
+            Message.ClientTimestamp = (float)(Now - (Options.LatencyMs - Options.ClockErrorMs) * 0.001);
+            Message.PressId = CurrentPress[Mode];
+            Outgoing.push_back(Message);
+            Stats.ShotsFired++;
+
+            if (CurrentPress[Mode] >= 0)
+            {
+                FPress& Press = Stats.Presses[CurrentPress[Mode]];
+                if (Press.FirstShotSent < 0.0)
+                {
+                    Press.FirstShotSent = Now;
+                }
+            }
+        }
+    };
+
+    class FSimServer
+    {
+    public:
+        std::vector<FMessage> Outgoing;
+
+        FSimServer(const FOptions& InOptions, FScenarioStats& InStats) : Options(InOptions), Stats(InStats)
+        {
+        }
+
+        void ReceiveStartFire(double Now, const FMessage& Message)
+        {
+            const uint8_t Mode = Message.FireMode;
+            const float ServerTime = (float)Now;
+
+            // ValidateFireRequest
+            bool bValid = true;
+            if (!NPFS::IsEventIndexValid(AuthoritativeFireEventIndex[Mode], Message.EventIndex))
+            {
+                Stats.RejectSequence++;
+                bValid = false;
+            }
+            else if (NPFS::IsTimestampDesynced(ServerTime, Message.ClientTimestamp))
+            {
+                Stats.RejectDesync++;
+                bValid = false;
+            }
+            else
+            {
+                for (int i = 0; i < NumModes; i++)
+                {
+                    if (NPFS::IsModeRecovering(LastFireTime[i], Options.Refire[i], ServerTime, NPFS::ServerRefireTolerance))
+                    {
+                        Stats.RejectRefire++;
+                        bValid = false;
+                        break;
+                    }
+                }
+            }
+
+            if (!bValid)
+            {
+                FMessage Confirm;
+                Confirm.Type = Msg_ClientConfirm;
+                Confirm.FireMode = Mode;
+                Confirm.EventIndex = AuthoritativeFireEventIndex[Mode];
+                Confirm.ClientTimestamp = 0.f;
+                Confirm.PressId = -1;
+                Outgoing.push_back(Confirm);
+                if (Options.bVerbose)
+                {
+                    std::printf("  %9.4f reject mode %u index %d (authoritative %d)\n", Now - StartTime, Mode, Message.EventIndex, AuthoritativeFireEventIndex[Mode]);
+                }
+                return;
+            }
+
+            AuthoritativeFireEventIndex[Mode] = Message.EventIndex;
+            LastFireTime[Mode] = NPFS::CompensatedFireTime(LastFireTime[Mode], Options.Refire[Mode], ServerTime);
+            Stats.ShotsAccepted++;
+            if (Message.PressId >= 0 && Stats.Presses[Message.PressId].FirstShotAccepted < 0.0)
+            {
+                Stats.Presses[Message.PressId].FirstShotAccepted = Now;
+            }
+        }
+
+    private:
+        const FOptions& Options;
+        FScenarioStats& Stats;
+        float LastFireTime[NumModes] = { -1.f, -1.f };
+        int32_t AuthoritativeFireEventIndex[NumModes] = { 0, 0 };
+    };
+
+    // ---------------------------------------------------------------
+    // SCENARIOS
+    // ---------------------------------------------------------------
+
+    struct FScenarioResult
+    {
+        int Fps;
+        std::string Pattern;
+        FScenarioStats Stats;
+        uint64_t PacketsLost = 0;
+        uint64_t PacketsOutOfOrder = 0;
+        /** Shots the transport dropped (--unreliable); they don't count against acceptance */
+        uint64_t ShotsDropped = 0;
+        double TtfsP50 = 0.0, TtfsP95 = 0.0, TtfsMax = 0.0;
+        double EndToEndP50 = 0.0, EndToEndP95 = 0.0;
+        double TtfsLimitMs = 0.0;
+        std::string Failure;
+    };
+
+    /** Accepted share of the shots that reached the server */
+    double AcceptedPct(const FScenarioResult& Result)
+    {
+        const uint64_t Delivered = Result.Stats.ShotsFired - Result.ShotsDropped;
+        return Delivered ? 100.0 * Result.Stats.ShotsAccepted / Delivered : 100.0;
+    }
+
+    double Percentile(std::vector<double> Values, double Fraction)
+    {
+        if (Values.empty())
+        {
+            return 0.0;
+        }
+        std::sort(Values.begin(), Values.end());
+        const size_t Index = (size_t)std::floor(Fraction * (Values.size() - 1) + 0.5);
+        return Values[std::min(Index, Values.size() - 1)];
+    }
+
+    FScenarioResult RunScenario(int Fps, const std::string& Pattern, const FOptions& Options)
+    {
+        FScenarioResult Result;
+        Result.Fps = Fps;
+        Result.Pattern = Pattern;
+
+        std::mt19937 Rng(Options.Seed * 7919u + (unsigned)Fps * 31u + (unsigned)std::hash<std::string>()(Pattern));
+        std::vector<FInputEvent> Input;
+        BuildPattern(Pattern, Options, Rng, Input);
+
+        const double FrameTime = 1.0 / Fps;
+        const double ServerTick = 1.0 / Options.ServerHz;
+        FSimLink ToServer(Options, ServerTick, Rng);
+        FSimLink ToClient(Options, FrameTime, Rng);
+        FSimClient Client(Options, Result.Stats);
+        FSimServer Server(Options, Result.Stats);
+
+        // Run past the last input (a held button keeps firing until its release) so in-flight
+        // shots and retransmits land
+        const double EndTime = (Input.empty() ? StartTime : Input.back().Time) + 1.0 + 8.0 * (Options.LatencyMs + Options.JitterMs) * 0.001;
+        size_t NextInput = 0;
+        uint64_t ClientFrame = 0, ServerFrame = 0;
+        std::vector<FMessage> Received;
+        for (;;)
+        {
+            const double ClientNow = StartTime + ClientFrame * FrameTime;
+            const double ServerNow = StartTime + ServerFrame * ServerTick;
+            if (ClientNow > EndTime && ServerNow > EndTime)
+            {
+                break;
+            }
+
+            if (ServerNow <= ClientNow)
+            {
+                Received.clear();
+                ToServer.Receive(ServerNow, Received);
+                for (const FMessage& Message : Received)
+                {
+                    Server.ReceiveStartFire(ServerNow, Message);
+                }
+                ToClient.Send(ServerNow, Server.Outgoing);
+                ServerFrame++;
+                continue;
+            }
+
+            Received.clear();
+            ToClient.Receive(ClientNow, Received);
+            for (const FMessage& Message : Received)
+            {
+                Client.ReceiveConfirm(Message);
+            }
+            for (; NextInput < Input.size() && Input[NextInput].Time <= ClientNow; NextInput++)
+            {
+                const FInputEvent& Event = Input[NextInput];
+                if (Event.bPress)
+                {
+                    Client.InputPress(ClientNow, Event.Time, Event.FireMode);
+                }
+                else
+                {
+                    Client.InputRelease(Event.FireMode);
+                }
+            }
+            Client.TickTimers(ClientNow);
+            ToServer.Send(ClientNow, Client.Outgoing);
+            ClientFrame++;
+        }
+
+        Result.PacketsLost = ToServer.PacketsLost + ToClient.PacketsLost;
+        Result.ShotsDropped = ToServer.MessagesDropped;
+        Result.PacketsOutOfOrder = ToServer.PacketsOutOfOrder + ToClient.PacketsOutOfOrder;
+
+        // Time to first shot: from the later of press and weapon-ready to the RPC leaving the client
+        std::vector<double> Ttfs, EndToEnd;
+        for (const FPress& Press : Result.Stats.Presses)
+        {
+            if (Press.FirstShotSent >= 0.0)
+            {
+                Ttfs.push_back(std::max(0.0, Press.FirstShotSent - Press.ReadyTime) * 1000.0);
+            }
+            if (Press.FirstShotAccepted >= 0.0)
+            {
+                EndToEnd.push_back((Press.FirstShotAccepted - Press.ReadyTime) * 1000.0);
+            }
+        }
+        Result.TtfsP50 = Percentile(Ttfs, 0.5);
+        Result.TtfsP95 = Percentile(Ttfs, 0.95);
+        Result.TtfsMax = Ttfs.empty() ? 0.0 : *std::max_element(Ttfs.begin(), Ttfs.end());
+        Result.EndToEndP50 = Percentile(EndToEnd, 0.5);
+        Result.EndToEndP95 = Percentile(EndToEnd, 0.95);
+
+        // Assertions
+        const FScenarioStats& S = Result.Stats;
+        const double AcceptPct = AcceptedPct(Result);
+        Result.TtfsLimitMs = Options.MaxTtfsMs >= 0.f ? Options.MaxTtfsMs : (FrameTime + NPFS::RetryPadding) * 1000.0 + 0.5;
+        char Buffer[128];
+        if (AcceptPct < Options.MinAcceptPct)
+        {
+            std::snprintf(Buffer, sizeof(Buffer), "accepted %.2f%% < %.2f%%", AcceptPct, Options.MinAcceptPct);
+            Result.Failure = Buffer;
+        }
+        else if ((int64_t)S.IndexRewinds > Options.MaxRewinds)
+        {
+            std::snprintf(Buffer, sizeof(Buffer), "%llu index rewinds > %d", (unsigned long long)S.IndexRewinds, Options.MaxRewinds);
+            Result.Failure = Buffer;
+        }
+        else if (Result.TtfsMax > Result.TtfsLimitMs)
+        {
+            std::snprintf(Buffer, sizeof(Buffer), "time to first shot %.1f ms > %.1f ms", Result.TtfsMax, Result.TtfsLimitMs);
+            Result.Failure = Buffer;
+        }
+        else if (S.ShotsFired == 0)
+        {
+            Result.Failure = "no shots fired";
+        }
+        return Result;
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: npfiresim [--fps 60,144,240,480] [--patterns hold,tap,switch,mixed] [--seconds 60]\n"
+            "                 [--latency-ms 40] [--jitter-ms 10] [--loss 0] [--reorder 0] [--reorder-ms 15]\n"
+            "                 [--clock-error-ms 0] [--server-hz 120] [--refire 0.6,0.35] [--unreliable]\n"
+            "                 [--min-accept 100] [--max-rewinds 0] [--max-ttfs-ms N] [--seed 1] [--csv] [--verbose]\n"
+            "  latency is one-way; loss and reorder are percentages of packets per direction\n");
+    }
+
+    std::vector<std::string> SplitList(const char* Text)
+    {
+        std::vector<std::string> Items;
+        std::stringstream List(Text);
+        std::string Item;
+        while (std::getline(List, Item, ','))
+        {
+            if (!Item.empty())
+            {
+                Items.push_back(Item);
+            }
+        }
+        return Items;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FOptions Options;
+    Options.FrameRates = { 60, 144, 240, 480 };
+    Options.Patterns = { "hold", "tap", "switch", "mixed" };
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+        const bool bHasValue = i + 1 < argc;
+        if (Arg == "--fps" && bHasValue)
+        {
+            Options.FrameRates.clear();
+            for (const std::string& Item : SplitList(argv[++i]))
+            {
+                const int Fps = std::atoi(Item.c_str());
+                if (Fps >= 10)
+                {
+                    Options.FrameRates.push_back(Fps);
+                }
+            }
+        }
+        else if (Arg == "--patterns" && bHasValue)
+        {
+            Options.Patterns = SplitList(argv[++i]);
+        }
+        else if (Arg == "--seconds" && bHasValue)
+        {
+            Options.Seconds = std::max(1.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--latency-ms" && bHasValue)
+        {
+            Options.LatencyMs = std::max(0.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--jitter-ms" && bHasValue)
+        {
+            Options.JitterMs = std::max(0.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--loss" && bHasValue)
+        {
+            Options.LossPct = std::min(90.f, std::max(0.f, (float)std::atof(argv[++i])));
+        }
+        else if (Arg == "--reorder" && bHasValue)
+        {
+            Options.ReorderPct = std::min(100.f, std::max(0.f, (float)std::atof(argv[++i])));
+        }
+        else if (Arg == "--reorder-ms" && bHasValue)
+        {
+            Options.ReorderMs = std::max(0.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--clock-error-ms" && bHasValue)
+        {
+            Options.ClockErrorMs = (float)std::atof(argv[++i]);
+        }
+        else if (Arg == "--server-hz" && bHasValue)
+        {
+            Options.ServerHz = std::max(10.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--refire" && bHasValue)
+        {
+            const std::vector<std::string> Items = SplitList(argv[++i]);
+            for (int Mode = 0; Mode < NumModes && Mode < (int)Items.size(); Mode++)
+            {
+                Options.Refire[Mode] = std::max(0.05f, (float)std::atof(Items[Mode].c_str()));
+            }
+        }
+        else if (Arg == "--unreliable")
+        {
+            Options.bUnreliable = true;
+        }
+        else if (Arg == "--min-accept" && bHasValue)
+        {
+            Options.MinAcceptPct = (float)std::atof(argv[++i]);
+        }
+        else if (Arg == "--max-rewinds" && bHasValue)
+        {
+            Options.MaxRewinds = std::atoi(argv[++i]);
+        }
+        else if (Arg == "--max-ttfs-ms" && bHasValue)
+        {
+            Options.MaxTtfsMs = (float)std::atof(argv[++i]);
+        }
+        else if (Arg == "--seed" && bHasValue)
+        {
+            Options.Seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (Arg == "--csv")
+        {
+            Options.bCsv = true;
+        }
+        else if (Arg == "--verbose")
+        {
+            Options.bVerbose = true;
+        }
+        else
+        {
+            PrintUsage();
+            return (Arg == "-h" || Arg == "--help") ? 0 : 1;
+        }
+    }
+    for (const std::string& Pattern : Options.Patterns)
+    {
+        std::mt19937 Rng;
+        std::vector<FInputEvent> Unused;
+        if (!BuildPattern(Pattern, Options, Rng, Unused))
+        {
+            std::fprintf(stderr, "unknown pattern '%s'\n", Pattern.c_str());
+            return 1;
+        }
+    }
+    if (Options.FrameRates.empty() || Options.Patterns.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (Options.bCsv)
+    {
+        std::printf("fps,pattern,fired,accepted,shots_dropped,reject_sequence,reject_desync,reject_refire,confirms,index_rewinds,dropped_presses,packets_lost,packets_out_of_order,ttfs_p50_ms,ttfs_p95_ms,ttfs_max_ms,e2e_p50_ms,e2e_p95_ms,result\n");
+    }
+    else
+    {
+        std::printf("%.0f s per scenario, %.0f ms one-way +%.0f ms jitter, %.1f%% loss, %.1f%% reorder (+%.0f ms), %s RPCs, server %.0f Hz, refire %.2f/%.2f s, seed %u\n\n",
+            Options.Seconds, Options.LatencyMs, Options.JitterMs, Options.LossPct, Options.ReorderPct, Options.ReorderMs,
+            Options.bUnreliable ? "unreliable" : "reliable", Options.ServerHz, Options.Refire[0], Options.Refire[1], Options.Seed);
+        std::printf("%4s %-7s %6s %6s %5s %7s %13s %5s %5s %5s %7s %7s %7s %7s %7s  %s\n",
+            "fps", "pattern", "fired", "acc", "lost", "acc%", "rej seq/ts/rf", "conf", "rewnd", "drop", "ttfs50", "ttfs95", "ttfsmax", "e2e50", "e2e95", "result");
+    }
+
+    int Failures = 0;
+    for (int Fps : Options.FrameRates)
+    {
+        for (const std::string& Pattern : Options.Patterns)
+        {
+            const FScenarioResult R = RunScenario(Fps, Pattern, Options);
+            const FScenarioStats& S = R.Stats;
+            const double AcceptPct = AcceptedPct(R);
+            const bool bPassed = R.Failure.empty();
+            Failures += bPassed ? 0 : 1;
+            if (Options.bCsv)
+            {
+                std::printf("%d,%s,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%.2f,%.2f,%.2f,%.2f,%.2f,%s\n", R.Fps, R.Pattern.c_str(),
+                    (unsigned long long)S.ShotsFired, (unsigned long long)S.ShotsAccepted, (unsigned long long)R.ShotsDropped, (unsigned long long)S.RejectSequence,
+                    (unsigned long long)S.RejectDesync, (unsigned long long)S.RejectRefire, (unsigned long long)S.ConfirmsReceived,
+                    (unsigned long long)S.IndexRewinds, (unsigned long long)S.DroppedPresses, (unsigned long long)R.PacketsLost,
+                    (unsigned long long)R.PacketsOutOfOrder, R.TtfsP50, R.TtfsP95, R.TtfsMax, R.EndToEndP50, R.EndToEndP95,
+                    bPassed ? "pass" : R.Failure.c_str());
+            }
+            else
+            {
+                char Rejects[32];
+                std::snprintf(Rejects, sizeof(Rejects), "%llu/%llu/%llu", (unsigned long long)S.RejectSequence, (unsigned long long)S.RejectDesync, (unsigned long long)S.RejectRefire);
+                std::printf("%4d %-7s %6llu %6llu %5llu %7.2f %13s %5llu %5llu %5llu %7.1f %7.1f %7.1f %7.1f %7.1f  %s\n", R.Fps, R.Pattern.c_str(),
+                    (unsigned long long)S.ShotsFired, (unsigned long long)S.ShotsAccepted, (unsigned long long)R.ShotsDropped, AcceptPct, Rejects,
+                    (unsigned long long)S.ConfirmsReceived, (unsigned long long)S.IndexRewinds, (unsigned long long)S.DroppedPresses,
+                    R.TtfsP50, R.TtfsP95, R.TtfsMax, R.EndToEndP50, R.EndToEndP95, bPassed ? "PASS" : ("FAIL: " + R.Failure).c_str());
+            }
+            std::fflush(stdout);
+        }
+    }
+
+    if (!Options.bCsv)
+    {
+        std::printf("\n%d scenario(s) failed\n", Failures);
+    }
+    return Failures ? 1 : 0;
+}
@@ -0,0 +1,516 @@
+// NetcodePlusNetRate.cpp
+// Headless model of ATeamArenaCharacter's adaptive replication rate. N players roam a square arena
+// with box pillars, look along their path or track an enemy, and trade hitscan fire when the enemy
+// is in view and unoccluded. Every pawn re-evaluates its per-viewer rates on the server's schedule
+// (UpdateAdaptiveNetRates: distance, view cone, budgeted stalest-first LOS traces, engagement hold)
+// through the same NetcodePlusNetRateKernel.h functions the game calls, and the run counts what
+// each replication scheme would send:
+//
+//   fixed      NetUpdateFrequency 100 for everyone (before adaptive rates)
+//   actor-max  NetUpdateFrequency = max over viewers, every connection takes every update
+//   per-conn   actor-max plus IsReplicationPausedForConnection pacing each connection to its rate
+//
+// "pause" counts the updates where a connection's paused state flips on, which costs the engine a
+// small bunch of its own. Movement ignores the pillars and the traces are 2D segment/box tests;
+// the point is the traffic shape, not the level.
+//
+// Build (Linux, no engine needed):
+//   g++ -std=c++11 -O2 -I../../Source/Public NetcodePlusNetRate.cpp -o npnetrate
+//
+// Usage:
+//   npnetrate [--players 8,16,32,64] [--seconds 60] [--seed 1] [--csv]
+
+#include "NetcodePlusNetRateKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Server defaults (ATeamArenaCharacter)
+    const float MaxRate = 100.f;
+    const float MinRate = 20.f;
+    const float NearDistance = 2000.f;
+    const float FarDistance = 8000.f;
+    const float ViewConeDot = 0.5f;
+    const float EngagementHoldTime = 1.f;
+    const float RateUpdateInterval = 0.25f;
+    const float LOSRecheckTime = 0.5f;
+    const int MaxLOSTracesPerUpdate = 4;
+
+    // Match model
+    const float ServerHz = 120.f;
+    const float ArenaSize = 10000.f;
+    const int NumPillars = 40;
+    const float RunSpeed = 940.f;
+    const float FightRange = 4000.f;
+    const float ShotsPerSecTracking = 3.f;
+
+    struct FVec2
+    {
+        float X;
+        float Y;
+    };
+
+    struct FBox2
+    {
+        float MinX;
+        float MinY;
+        float MaxX;
+        float MaxY;
+    };
+
+    /** Mirrors FViewerNetRate, plus the paused state the engine keeps on the actor channel */
+    struct FViewerState
+    {
+        float DesiredRate = MaxRate;
+        float LastEngagedTime = -1000.f;
+        bool bLineOfSightBlocked = false;
+        float LastLOSTraceTime = -1000.f;
+        float NextReplicationTime = 0.f;
+        bool bPaused = false;
+    };
+
+    struct FPlayer
+    {
+        FVec2 Location;
+        FVec2 Waypoint;
+        FVec2 ViewDir;
+        int Team = 0;
+        int Focus = -1;
+        float NextFocusTime = 0.f;
+        float NextRateUpdate = 0.f;
+        float NetUpdateFrequency = MaxRate;
+        float NextUpdateFixed = 0.f;
+        float NextUpdateAdaptive = 0.f;
+        std::vector<FViewerState> Viewers;
+    };
+
+    struct FOptions
+    {
+        std::vector<int> PlayerCounts = { 8, 16, 32, 64 };
+        float Seconds = 60.f;
+        unsigned Seed = 1;
+        bool bCsv = false;
+    };
+
+    struct FRunResult
+    {
+        int Players = 0;
+        double Seconds = 0.0;
+        uint64_t FixedSends = 0;
+        uint64_t ActorMaxSends = 0;
+        uint64_t PerConnSends = 0;
+        uint64_t PauseFlips = 0;
+        uint64_t EngagedFixedSends = 0;
+        uint64_t EngagedActorMaxSends = 0;
+        uint64_t EngagedPerConnSends = 0;
+        double EngagedPairSeconds = 0.0;
+        uint64_t LOSTraces = 0;
+        float MaxLOSAge = 0.f;
+    };
+
+    float Length(FVec2 V)
+    {
+        return std::sqrt(V.X * V.X + V.Y * V.Y);
+    }
+
+    FVec2 Sub(FVec2 A, FVec2 B)
+    {
+        return FVec2{ A.X - B.X, A.Y - B.Y };
+    }
+
+    FVec2 Normalize(FVec2 V)
+    {
+        const float Len = Length(V);
+        return Len > 0.f ? FVec2{ V.X / Len, V.Y / Len } : FVec2{ 1.f, 0.f };
+    }
+
+    /** Slab test: does segment A-B cross Box? */
+    bool SegmentHitsBox(FVec2 A, FVec2 B, const FBox2& Box)
+    {
+        float TMin = 0.f;
+        float TMax = 1.f;
+        const float Start[2] = { A.X, A.Y };
+        const float Delta[2] = { B.X - A.X, B.Y - A.Y };
+        const float Lo[2] = { Box.MinX, Box.MinY };
+        const float Hi[2] = { Box.MaxX, Box.MaxY };
+        for (int Axis = 0; Axis < 2; ++Axis)
+        {
+            if (std::fabs(Delta[Axis]) < 1e-6f)
+            {
+                if (Start[Axis] < Lo[Axis] || Start[Axis] > Hi[Axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+            float T0 = (Lo[Axis] - Start[Axis]) / Delta[Axis];
+            float T1 = (Hi[Axis] - Start[Axis]) / Delta[Axis];
+            if (T0 > T1)
+            {
+                std::swap(T0, T1);
+            }
+            TMin = std::max(TMin, T0);
+            TMax = std::min(TMax, T1);
+            if (TMin > TMax)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsBlocked(FVec2 A, FVec2 B, const std::vector<FBox2>& Pillars)
+    {
+        for (const FBox2& Box : Pillars)
+        {
+            if (SegmentHitsBox(A, B, Box))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** ATeamArenaCharacter::NotifyHitScanEngagement */
+    void NotifyEngagement(FPlayer& Pawn, int Viewer, float Now)
+    {
+        FViewerState& Entry = Pawn.Viewers[Viewer];
+        Entry.LastEngagedTime = Now;
+        Entry.NextReplicationTime = 0.f;
+        if (Entry.DesiredRate < MaxRate)
+        {
+            Entry.DesiredRate = MaxRate;
+            Pawn.NetUpdateFrequency = MaxRate;
+            Pawn.NextUpdateAdaptive = Now;
+        }
+    }
+
+    /** ATeamArenaCharacter::UpdateAdaptiveNetRates for one pawn */
+    void UpdateRates(std::vector<FPlayer>& Players, int PawnIndex, const std::vector<FBox2>& Pillars, float Now, FRunResult& Result)
+    {
+        struct FCandidate
+        {
+            int Viewer;
+            float Relevance;
+            bool bWantsLOS;
+        };
+        std::vector<FCandidate> Candidates;
+        FPlayer& Pawn = Players[PawnIndex];
+
+        for (int Viewer = 0; Viewer < (int)Players.size(); ++Viewer)
+        {
+            if (Viewer == PawnIndex)
+            {
+                continue;
+            }
+            FViewerState& Entry = Pawn.Viewers[Viewer];
+            if (Now - Entry.LastEngagedTime < EngagementHoldTime)
+            {
+                Entry.DesiredRate = MaxRate;
+                continue;
+            }
+            const FVec2 ToUs = Sub(Pawn.Location, Players[Viewer].Location);
+            const float Distance = Length(ToUs);
+            float Relevance = NetcodePlusNetRate::DistanceRelevance(Distance, NearDistance, FarDistance);
+            const FVec2 Dir = Players[Viewer].ViewDir;
+            const bool bInView = Distance < 1.f || (ToUs.X * Dir.X + ToUs.Y * Dir.Y) / Distance >= ViewConeDot;
+            if (!bInView)
+            {
+                Relevance *= NetcodePlusNetRate::OutOfViewScale;
+            }
+            Candidates.push_back(FCandidate{ Viewer, Relevance, bInView && Relevance > 0.f });
+        }
+
+        std::vector<int> Stale;
+        for (int i = 0; i < (int)Candidates.size(); ++i)
+        {
+            if (Candidates[i].bWantsLOS && Now - Pawn.Viewers[Candidates[i].Viewer].LastLOSTraceTime >= LOSRecheckTime)
+            {
+                Stale.push_back(i);
+            }
+        }
+        if ((int)Stale.size() > MaxLOSTracesPerUpdate)
+        {
+            std::sort(Stale.begin(), Stale.end(), [&](int A, int B)
+            {
+                return Pawn.Viewers[Candidates[A].Viewer].LastLOSTraceTime < Pawn.Viewers[Candidates[B].Viewer].LastLOSTraceTime;
+            });
+            Stale.resize(MaxLOSTracesPerUpdate);
+        }
+        for (int CandidateIndex : Stale)
+        {
+            const int Viewer = Candidates[CandidateIndex].Viewer;
+            FViewerState& Entry = Pawn.Viewers[Viewer];
+            Entry.bLineOfSightBlocked = IsBlocked(Players[Viewer].Location, Pawn.Location, Pillars);
+            Entry.LastLOSTraceTime = Now;
+            ++Result.LOSTraces;
+        }
+
+        float Rate = MinRate;
+        for (const FCandidate& Candidate : Candidates)
+        {
+            FViewerState& Entry = Pawn.Viewers[Candidate.Viewer];
+            float Relevance = Candidate.Relevance;
+            if (Candidate.bWantsLOS)
+            {
+                if (Entry.LastLOSTraceTime > 0.f)
+                {
+                    Result.MaxLOSAge = std::max(Result.MaxLOSAge, Now - Entry.LastLOSTraceTime);
+                }
+                if (Entry.bLineOfSightBlocked)
+                {
+                    Relevance *= NetcodePlusNetRate::OccludedScale;
+                }
+            }
+            Entry.DesiredRate = NetcodePlusNetRate::DesiredRate(MinRate, MaxRate, Relevance);
+        }
+        for (int Viewer = 0; Viewer < (int)Players.size(); ++Viewer)
+        {
+            if (Viewer != PawnIndex)
+            {
+                Rate = std::max(Rate, Pawn.Viewers[Viewer].DesiredRate);
+            }
+        }
+        Pawn.NetUpdateFrequency = Rate;
+    }
+
+    FRunResult RunMatch(int NumPlayers, const FOptions& Options)
+    {
+        std::mt19937 Rng(Options.Seed);
+        std::uniform_real_distribution<float> Unit(0.f, 1.f);
+        auto RandomPoint = [&]() { return FVec2{ ArenaSize * Unit(Rng), ArenaSize * Unit(Rng) }; };
+
+        std::vector<FBox2> Pillars;
+        for (int i = 0; i < NumPillars; ++i)
+        {
+            const FVec2 Center = RandomPoint();
+            const float HalfX = 200.f + 400.f * Unit(Rng);
+            const float HalfY = 200.f + 400.f * Unit(Rng);
+            Pillars.push_back(FBox2{ Center.X - HalfX, Center.Y - HalfY, Center.X + HalfX, Center.Y + HalfY });
+        }
+
+        std::vector<FPlayer> Players(NumPlayers);
+        for (int i = 0; i < NumPlayers; ++i)
+        {
+            FPlayer& Player = Players[i];
+            Player.Location = RandomPoint();
+            Player.Waypoint = RandomPoint();
+            Player.ViewDir = Normalize(Sub(Player.Waypoint, Player.Location));
+            Player.Team = i & 1;
+            Player.NextRateUpdate = RateUpdateInterval * Unit(Rng);
+            Player.Viewers.resize(NumPlayers);
+        }
+
+        FRunResult Result;
+        Result.Players = NumPlayers;
+        Result.Seconds = Options.Seconds;
+
+        const float DeltaTime = 1.f / ServerHz;
+        const int Frames = (int)(Options.Seconds * ServerHz);
+        for (int Frame = 0; Frame < Frames; ++Frame)
+        {
+            const float Now = Frame * DeltaTime;
+
+            // Move and aim
+            for (int i = 0; i < NumPlayers; ++i)
+            {
+                FPlayer& Player = Players[i];
+                FVec2 ToWaypoint = Sub(Player.Waypoint, Player.Location);
+                if (Length(ToWaypoint) < RunSpeed * DeltaTime)
+                {
+                    Player.Waypoint = RandomPoint();
+                    ToWaypoint = Sub(Player.Waypoint, Player.Location);
+                }
+                const FVec2 MoveDir = Normalize(ToWaypoint);
+                Player.Location.X += MoveDir.X * RunSpeed * DeltaTime;
+                Player.Location.Y += MoveDir.Y * RunSpeed * DeltaTime;
+
+                if (Now >= Player.NextFocusTime)
+                {
+                    Player.NextFocusTime = Now + 1.f + 2.f * Unit(Rng);
+                    const int Pick = (int)(Rng() % NumPlayers);
+                    Player.Focus = (Unit(Rng) < 0.6f && Players[Pick].Team != Player.Team) ? Pick : -1;
+                }
+                Player.ViewDir = (Player.Focus >= 0) ? Normalize(Sub(Players[Player.Focus].Location, Player.Location)) : MoveDir;
+            }
+
+            // Fire at a tracked enemy that is close and in the open
+            for (int i = 0; i < NumPlayers; ++i)
+            {
+                const int Target = Players[i].Focus;
+                if (Target < 0 || Length(Sub(Players[Target].Location, Players[i].Location)) > FightRange)
+                {
+                    continue;
+                }
+                if (Unit(Rng) < ShotsPerSecTracking * DeltaTime && !IsBlocked(Players[i].Location, Players[Target].Location, Pillars))
+                {
+                    NotifyEngagement(Players[Target], i, Now);
+                    NotifyEngagement(Players[i], Target, Now);
+                }
+            }
+
+            for (int PawnIndex = 0; PawnIndex < NumPlayers; ++PawnIndex)
+            {
+                FPlayer& Pawn = Players[PawnIndex];
+                if (Now >= Pawn.NextRateUpdate)
+                {
+                    Pawn.NextRateUpdate += RateUpdateInterval;
+                    UpdateRates(Players, PawnIndex, Pillars, Now, Result);
+                }
+
+                // UNetDriver::ServerReplicateActors: next consideration one interval out plus up to a tick of jitter
+                if (Now >= Pawn.NextUpdateFixed)
+                {
+                    Pawn.NextUpdateFixed = Now + DeltaTime * Unit(Rng) + 1.f / MaxRate;
+                    Result.FixedSends += NumPlayers - 1;
+                    for (int Viewer = 0; Viewer < NumPlayers; ++Viewer)
+                    {
+                        Result.EngagedFixedSends += (Viewer != PawnIndex && Now - Pawn.Viewers[Viewer].LastEngagedTime < EngagementHoldTime);
+                    }
+                }
+                if (Now >= Pawn.NextUpdateAdaptive)
+                {
+                    Pawn.NextUpdateAdaptive = Now + DeltaTime * Unit(Rng) + 1.f / Pawn.NetUpdateFrequency;
+                    for (int Viewer = 0; Viewer < NumPlayers; ++Viewer)
+                    {
+                        if (Viewer == PawnIndex)
+                        {
+                            continue;
+                        }
+                        FViewerState& Entry = Pawn.Viewers[Viewer];
+                        const bool bEngaged = Now - Entry.LastEngagedTime < EngagementHoldTime;
+                        const bool bSend = NetcodePlusNetRate::ShouldReplicate(Entry.NextReplicationTime, Now, Entry.DesiredRate);
+                        ++Result.ActorMaxSends;
+                        Result.EngagedActorMaxSends += bEngaged;
+                        Result.PerConnSends += bSend;
+                        Result.EngagedPerConnSends += (bEngaged && bSend);
+                        if (!bSend && !Entry.bPaused)
+                        {
+                            ++Result.PauseFlips;
+                        }
+                        Entry.bPaused = !bSend;
+                    }
+                }
+
+                for (int Viewer = 0; Viewer < NumPlayers; ++Viewer)
+                {
+                    if (Viewer != PawnIndex && Now - Pawn.Viewers[Viewer].LastEngagedTime < EngagementHoldTime)
+                    {
+                        Result.EngagedPairSeconds += DeltaTime;
+                    }
+                }
+            }
+        }
+        return Result;
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: npnetrate [--players 8,16,32,64] [--seconds 60] [--seed 1] [--csv]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FOptions Options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+        const bool bHasValue = i + 1 < argc;
+        if (Arg == "--players" && bHasValue)
+        {
+            Options.PlayerCounts.clear();
+            std::stringstream List(argv[++i]);
+            std::string Item;
+            while (std::getline(List, Item, ','))
+            {
+                const int Count = std::atoi(Item.c_str());
+                if (Count >= 2)
+                {
+                    Options.PlayerCounts.push_back(Count);
+                }
+            }
+        }
+        else if (Arg == "--seconds" && bHasValue)
+        {
+            Options.Seconds = std::max(1.f, (float)std::atof(argv[++i]));
+        }
+        else if (Arg == "--seed" && bHasValue)
+        {
+            Options.Seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (Arg == "--csv")
+        {
+            Options.bCsv = true;
+        }
+        else
+        {
+            PrintUsage();
+            return (Arg == "-h" || Arg == "--help") ? 0 : 1;
+        }
+    }
+    if (Options.PlayerCounts.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (Options.bCsv)
+    {
+        std::printf("players,mode,updates_per_sec,per_conn_per_sec,pause_per_conn_per_sec,engaged_hz,los_traces_per_sec,max_los_age_ms\n");
+    }
+    else
+    {
+        std::printf("%.0f s simulated per run, seed %u\n\n", Options.Seconds, Options.Seed);
+        std::printf("%7s %9s %10s %9s %9s %8s %8s %8s\n", "players", "mode", "upd/s", "conn/s", "pause/s", "eng Hz", "los/s", "los age");
+    }
+
+    for (int NumPlayers : Options.PlayerCounts)
+    {
+        const FRunResult R = RunMatch(NumPlayers, Options);
+        const double Connections = R.Players;
+        const double EngagedHzFixed = R.EngagedPairSeconds > 0.0 ? R.EngagedFixedSends / R.EngagedPairSeconds : 0.0;
+        const double EngagedHzActorMax = R.EngagedPairSeconds > 0.0 ? R.EngagedActorMaxSends / R.EngagedPairSeconds : 0.0;
+        const double EngagedHzPerConn = R.EngagedPairSeconds > 0.0 ? R.EngagedPerConnSends / R.EngagedPairSeconds : 0.0;
+        const double LOSPerSec = R.LOSTraces / R.Seconds;
+        const double MaxLOSAgeMs = 1000.0 * R.MaxLOSAge;
+
+        struct FRow
+        {
+            const char* Mode;
+            uint64_t Sends;
+            uint64_t Pauses;
+            double EngagedHz;
+        };
+        const FRow Rows[] =
+        {
+            { "fixed", R.FixedSends, 0, EngagedHzFixed },
+            { "actor-max", R.ActorMaxSends, 0, EngagedHzActorMax },
+            { "per-conn", R.PerConnSends, R.PauseFlips, EngagedHzPerConn },
+        };
+        for (const FRow& Row : Rows)
+        {
+            const double PerSec = Row.Sends / R.Seconds;
+            const double PausePerConn = Row.Pauses / R.Seconds / Connections;
+            if (Options.bCsv)
+            {
+                std::printf("%d,%s,%.0f,%.1f,%.1f,%.1f,%.1f,%.0f\n", R.Players, Row.Mode, PerSec, PerSec / Connections, PausePerConn, Row.EngagedHz, LOSPerSec, MaxLOSAgeMs);
+            }
+            else
+            {
+                std::printf("%7d %9s %10.0f %9.1f %9.1f %8.1f %8.1f %8.0f\n", R.Players, Row.Mode, PerSec, PerSec / Connections, PausePerConn, Row.EngagedHz, LOSPerSec, MaxLOSAgeMs);
+            }
+        }
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,454 @@
+// NetcodePlusReplay.cpp
+// Offline replayer for netcode session recordings (*.npsession, see
+// Source/Public/NetcodePlusSessionFormat.h, recorded with np.RecordStart on a server).
+// Rebuilds every pawn's saved-position history from the recording and re-runs the hitscan pawn
+// pass through NetcodePlusLagCompKernel.h - the same code AUTWeaponFix::HitScanTrace uses - so:
+//   - a plain run checks the replay reproduces the server's results (agreement should be ~100%)
+//   - --padding / --rewind-offset-ms / --rewind-scale show what a lag-comp change would have
+//     done to the same match (results that flip, claims confirmed before/after)
+//   - --repeat N times the pawn pass for a repeatable ns/shot figure on real data
+//
+// Build (Linux, no engine needed):
+//   g++ -std=c++11 -O2 -I../../Source/Public NetcodePlusReplay.cpp -o npreplay
+//
+// Usage:
+//   npreplay [options] file.npsession
+
+#include "NetcodePlusSessionFormat.h"
+#include "NetcodePlusLagCompKernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using NetcodePlusLagComp::FNPVec3;
+
+namespace
+{
+    struct FSample
+    {
+        FNPVec3 Position;
+        float Time;
+        bool bTeleported;
+    };
+
+    struct FPawn
+    {
+        bool bAlive = false;
+        uint8_t TeamNum = 255;
+        float MaxSavedPositionAge = 0.35f;
+        std::vector<FSample> History;
+        FNPVec3 Location;
+        FNPVec3 Velocity;
+        NetcodePlusLagComp::FCapsuleQuery Capsule = { 42.f, 92.f, false, 55.f, 0.f };
+    };
+
+    struct FOptions
+    {
+        /** Negative = use the recorded value */
+        float PaddingMoving = -1.f;
+        float PaddingStationary = -1.f;
+        float RewindOffsetMs = 0.f;
+        float RewindScale = 1.f;
+        int Repeat = 1;
+        bool bVerbose = false;
+        std::string File;
+
+        bool ChangesValidation() const
+        {
+            return PaddingMoving >= 0.f || PaddingStationary >= 0.f || RewindOffsetMs != 0.f || RewindScale != 1.f;
+        }
+    };
+
+    struct FReplayStats
+    {
+        uint64_t Records = 0;
+        uint64_t Ticks = 0;
+        uint64_t PawnMoves = 0;
+        uint64_t Samples = 0;
+        uint64_t FireRpcs = 0;
+        uint64_t FireRejected = 0;
+        uint64_t BeamRpcs[3] = {};
+        int64_t BeamDamage = 0;
+
+        uint64_t HitScans = 0;
+        uint64_t Agree = 0;
+        uint64_t RecordedHits = 0;
+        uint64_t ReplayHits = 0;
+        uint64_t Claims = 0;
+        uint64_t RecordedClaimsConfirmed = 0;
+        uint64_t ReplayClaimsConfirmed = 0;
+        uint64_t FlipHitToMiss = 0;
+        uint64_t FlipMissToHit = 0;
+        uint64_t FlipTarget = 0;
+
+        uint64_t CandidateTests = 0;
+        double PawnPassNs = 0.0;
+        float FirstTime = 0.f;
+        float LastTime = 0.f;
+    };
+
+    FNPVec3 ToVec(const float* V)
+    {
+        return FNPVec3(V[0], V[1], V[2]);
+    }
+
+    /** The pawn loop of AUTWeaponFix::HitScanTrace, over the replayed world */
+    int32_t RunPawnPass(const std::vector<FPawn>& Pawns, const FNPSessionHitScan& Scan, const FOptions& Options, uint64_t& OutTests)
+    {
+        const FNPVec3 Start = ToVec(Scan.Start);
+        const FNPVec3 End = ToVec(Scan.PawnTraceEnd);
+        const float PaddingMoving = Options.PaddingMoving >= 0.f ? Options.PaddingMoving : Scan.PaddingMoving;
+        const float PaddingStationary = Options.PaddingStationary >= 0.f ? Options.PaddingStationary : Scan.PaddingStationary;
+        const float PredictionTime = Scan.PredictionTime > 0.f ? (Scan.PredictionTime * Options.RewindScale + Options.RewindOffsetMs * 0.001f) : 0.f;
+
+        int32_t BestTarget = NPSESSION_NO_PAWN;
+        float BestDistSq = 0.f;
+        for (int32_t PawnId = 0; PawnId < (int32_t)Pawns.size(); ++PawnId)
+        {
+            const FPawn& Pawn = Pawns[PawnId];
+            if (!Pawn.bAlive || PawnId == Scan.ShooterPawnId || (Scan.SkipTeam != 255 && Pawn.TeamNum == Scan.SkipTeam))
+            {
+                continue;
+            }
+            ++OutTests;
+
+            NetcodePlusLagComp::FCapsuleQuery Capsule = Pawn.Capsule;
+            Capsule.ExtraPadding = NetcodePlusLagComp::ClaimedTargetPadding(PawnId == Scan.ClaimedPawnId, Pawn.Velocity, PaddingMoving, PaddingStationary);
+
+            const FNPVec3 TargetLocation = (PredictionTime > 0.f)
+                ? NetcodePlusLagComp::RewindLocation(Pawn.History.data(), (int32_t)Pawn.History.size(), Pawn.Location, Scan.Time - PredictionTime)
+                : Pawn.Location;
+
+            FNPVec3 ClosestPoint, ClosestCapsulePoint;
+            if (NetcodePlusLagComp::TraceHitsCapsule(Start, End, Scan.TraceRadius, TargetLocation, Capsule, ClosestPoint, ClosestCapsulePoint))
+            {
+                const float DistSq = NetcodePlusLagComp::DistSquared(ClosestPoint, Start);
+                if (BestTarget == NPSESSION_NO_PAWN || DistSq < BestDistSq)
+                {
+                    BestTarget = PawnId;
+                    BestDistSq = DistSq;
+                }
+            }
+        }
+        return BestTarget;
+    }
+
+    FPawn& GetPawn(std::vector<FPawn>& Pawns, int32_t PawnId)
+    {
+        if (PawnId >= (int32_t)Pawns.size())
+        {
+            Pawns.resize(PawnId + 1);
+        }
+        return Pawns[PawnId];
+    }
+
+    void OnHitScan(std::vector<FPawn>& Pawns, const FNPSessionHitScan& Scan, const FOptions& Options, FReplayStats& Stats)
+    {
+        int32_t Result = NPSESSION_NO_PAWN;
+        const auto StartClock = std::chrono::steady_clock::now();
+        for (int i = 0; i < Options.Repeat; ++i)
+        {
+            Result = RunPawnPass(Pawns, Scan, Options, Stats.CandidateTests);
+        }
+        Stats.PawnPassNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - StartClock).count();
+
+        ++Stats.HitScans;
+        Stats.RecordedHits += (Scan.ResultPawnId != NPSESSION_NO_PAWN);
+        Stats.ReplayHits += (Result != NPSESSION_NO_PAWN);
+        if (Scan.ClaimedPawnId != NPSESSION_NO_PAWN)
+        {
+            ++Stats.Claims;
+            Stats.RecordedClaimsConfirmed += (Scan.ResultPawnId == Scan.ClaimedPawnId);
+            Stats.ReplayClaimsConfirmed += (Result == Scan.ClaimedPawnId);
+        }
+
+        if (Result == Scan.ResultPawnId)
+        {
+            ++Stats.Agree;
+            return;
+        }
+        if (Result == NPSESSION_NO_PAWN)
+        {
+            ++Stats.FlipHitToMiss;
+        }
+        else if (Scan.ResultPawnId == NPSESSION_NO_PAWN)
+        {
+            ++Stats.FlipMissToHit;
+        }
+        else
+        {
+            ++Stats.FlipTarget;
+        }
+        if (Options.bVerbose)
+        {
+            std::printf("  t=%.3f shooter %d claimed %d: recorded %d, replay %d (rewind %.1fms)\n",
+                Scan.Time, Scan.ShooterPawnId, Scan.ClaimedPawnId, Scan.ResultPawnId, Result, Scan.PredictionTime * 1000.f);
+        }
+    }
+
+    bool Replay(const uint8_t* Data, size_t Size, const FOptions& Options, FReplayStats& Stats)
+    {
+        if (Size < sizeof(FNPSessionFileHeader))
+        {
+            std::fprintf(stderr, "%s: too small\n", Options.File.c_str());
+            return false;
+        }
+        const FNPSessionFileHeader* Header = reinterpret_cast<const FNPSessionFileHeader*>(Data);
+        if (Header->Magic != NPSESSION_MAGIC)
+        {
+            std::fprintf(stderr, "%s: not a NetcodePlus session recording\n", Options.File.c_str());
+            return false;
+        }
+        if (Header->Version > NPSESSION_VERSION)
+        {
+            std::fprintf(stderr, "%s: version %u is newer than this tool (%u)\n", Options.File.c_str(), Header->Version, NPSESSION_VERSION);
+            return false;
+        }
+        char MapName[NPSESSION_NAME_LEN + 1] = {};
+        std::memcpy(MapName, Header->MapName, NPSESSION_NAME_LEN);
+        std::printf("%s: map %s, %zu bytes\n", Options.File.c_str(), MapName, Size);
+
+        std::vector<FPawn> Pawns;
+        bool bFirstTick = true;
+        size_t Offset = Header->HeaderSize;
+        while (Offset + sizeof(FNPSessionRecordHeader) <= Size)
+        {
+            const FNPSessionRecordHeader* Record = reinterpret_cast<const FNPSessionRecordHeader*>(Data + Offset);
+            const uint8_t* Payload = Data + Offset + sizeof(FNPSessionRecordHeader);
+            Offset += sizeof(FNPSessionRecordHeader) + Record->Size;
+            if (Offset > Size)
+            {
+                break; // truncated tail (server died mid-write)
+            }
+            ++Stats.Records;
+
+            // Known payloads are read in place when the writer's struct is at least as big as ours
+            switch (Record->Type)
+            {
+            case NPSessionRecord_Tick:
+                if (Record->Size >= sizeof(FNPSessionTick))
+                {
+                    const FNPSessionTick* Tick = reinterpret_cast<const FNPSessionTick*>(Payload);
+                    if (bFirstTick)
+                    {
+                        Stats.FirstTime = Tick->WorldTime;
+                        bFirstTick = false;
+                    }
+                    Stats.LastTime = Tick->WorldTime;
+                    ++Stats.Ticks;
+                }
+                break;
+            case NPSessionRecord_PawnAdd:
+                if (Record->Size >= sizeof(FNPSessionPawnAdd))
+                {
+                    const FNPSessionPawnAdd* Add = reinterpret_cast<const FNPSessionPawnAdd*>(Payload);
+                    FPawn& Pawn = GetPawn(Pawns, Add->PawnId);
+                    Pawn.bAlive = true;
+                    Pawn.TeamNum = Add->TeamNum;
+                    Pawn.MaxSavedPositionAge = Add->MaxSavedPositionAge;
+                }
+                break;
+            case NPSessionRecord_PawnMove:
+                if (Record->Size >= sizeof(FNPSessionPawnMove))
+                {
+                    const FNPSessionPawnMove* Move = reinterpret_cast<const FNPSessionPawnMove*>(Payload);
+                    FPawn& Pawn = GetPawn(Pawns, Move->PawnId);
+                    ++Stats.PawnMoves;
+                    if (!(Move->Flags & NPSessionPawn_HistorySeed))
+                    {
+                        Pawn.Location = ToVec(Move->Location);
+                        Pawn.Velocity = ToVec(Move->Velocity);
+                        Pawn.Capsule.Radius = Move->Radius;
+                        Pawn.Capsule.HalfHeight = Move->HalfHeight;
+                        Pawn.Capsule.SlideTargetHeight = Move->SlideTargetHeight;
+                        Pawn.Capsule.bSliding = (Move->Flags & NPSessionPawn_Sliding) != 0;
+                    }
+                    if (Move->Flags & NPSessionPawn_SampleSaved)
+                    {
+                        FSample Sample;
+                        Sample.Position = ToVec(Move->Location);
+                        Sample.Time = Move->Time;
+                        Sample.bTeleported = (Move->Flags & NPSessionPawn_Teleported) != 0;
+                        Pawn.History.push_back(Sample);
+                        ++Stats.Samples;
+                        if (!(Move->Flags & NPSessionPawn_HistorySeed) &&
+                            NetcodePlusLagComp::ShouldTrimOldestSample((int32_t)Pawn.History.size(), Pawn.History.size() > 1 ? Pawn.History[1].Time : 0.f, Move->Time, Pawn.MaxSavedPositionAge))
+                        {
+                            Pawn.History.erase(Pawn.History.begin());
+                        }
+                    }
+                }
+                break;
+            case NPSessionRecord_PawnRemove:
+                if (Record->Size >= sizeof(FNPSessionPawnRemove))
+                {
+                    const FNPSessionPawnRemove* Remove = reinterpret_cast<const FNPSessionPawnRemove*>(Payload);
+                    FPawn& Pawn = GetPawn(Pawns, Remove->PawnId);
+                    Pawn.bAlive = false;
+                    Pawn.History.clear();
+                    Pawn.History.shrink_to_fit();
+                }
+                break;
+            case NPSessionRecord_FireRpc:
+                if (Record->Size >= sizeof(FNPSessionFireRpc))
+                {
+                    const FNPSessionFireRpc* Rpc = reinterpret_cast<const FNPSessionFireRpc*>(Payload);
+                    ++Stats.FireRpcs;
+                    Stats.FireRejected += (Rpc->bAccepted == 0);
+                }
+                break;
+            case NPSessionRecord_BeamRpc:
+                if (Record->Size >= sizeof(FNPSessionBeamRpc))
+                {
+                    const FNPSessionBeamRpc* Rpc = reinterpret_cast<const FNPSessionBeamRpc*>(Payload);
+                    if (Rpc->Kind < 3)
+                    {
+                        ++Stats.BeamRpcs[Rpc->Kind];
+                    }
+                    // Stream updates carry a running total; only batches and stream ends are additive
+                    if (Rpc->Kind != NPSessionBeam_Stream)
+                    {
+                        Stats.BeamDamage += Rpc->Damage;
+                    }
+                }
+                break;
+            case NPSessionRecord_HitScan:
+                if (Record->Size >= sizeof(FNPSessionHitScan))
+                {
+                    OnHitScan(Pawns, *reinterpret_cast<const FNPSessionHitScan*>(Payload), Options, Stats);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        return true;
+    }
+
+    double Percent(uint64_t Part, uint64_t Whole)
+    {
+        return Whole ? 100.0 * double(Part) / double(Whole) : 0.0;
+    }
+
+    void PrintReport(const FReplayStats& Stats, const FOptions& Options)
+    {
+        std::printf("  %.1f s, %llu ticks, %llu records, %llu pawn moves, %llu saved samples\n",
+            Stats.LastTime - Stats.FirstTime, (unsigned long long)Stats.Ticks, (unsigned long long)Stats.Records,
+            (unsigned long long)Stats.PawnMoves, (unsigned long long)Stats.Samples);
+        std::printf("  fire RPCs %llu (%llu rejected by ValidateFireRequest), beam RPCs stream %llu / end %llu / legacy %llu, beam damage claimed %lld\n",
+            (unsigned long long)Stats.FireRpcs, (unsigned long long)Stats.FireRejected,
+            (unsigned long long)Stats.BeamRpcs[NPSessionBeam_Stream], (unsigned long long)Stats.BeamRpcs[NPSessionBeam_StreamEnd],
+            (unsigned long long)Stats.BeamRpcs[NPSessionBeam_LegacyBatch], (long long)Stats.BeamDamage);
+
+        std::printf("\nhitscan validation: %llu shots\n", (unsigned long long)Stats.HitScans);
+        std::printf("  %-22s %10s %10s\n", "", "recorded", "replay");
+        std::printf("  %-22s %10llu %10llu\n", "pawn hits", (unsigned long long)Stats.RecordedHits, (unsigned long long)Stats.ReplayHits);
+        std::printf("  %-22s %9.2f%% %9.2f%%\n", "claims confirmed", Percent(Stats.RecordedClaimsConfirmed, Stats.Claims), Percent(Stats.ReplayClaimsConfirmed, Stats.Claims));
+        std::printf("  same result            %llu (%.2f%%)%s\n", (unsigned long long)Stats.Agree, Percent(Stats.Agree, Stats.HitScans),
+            Options.ChangesValidation() ? "" : "   <- should be ~100% with no overrides");
+        std::printf("  hit -> miss %llu, miss -> hit %llu, different target %llu\n",
+            (unsigned long long)Stats.FlipHitToMiss, (unsigned long long)Stats.FlipMissToHit, (unsigned long long)Stats.FlipTarget);
+
+        const uint64_t Passes = Stats.HitScans * (uint64_t)Options.Repeat;
+        if (Passes > 0)
+        {
+            std::printf("\npawn pass: %.1f ns/shot, %.2f candidates/shot (%d repeat%s)\n",
+                Stats.PawnPassNs / Passes, double(Stats.CandidateTests) / Passes, Options.Repeat, Options.Repeat == 1 ? "" : "s");
+        }
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: npreplay [options] file.npsession\n"
+            "  --padding UU             HitScanPadding for moving claimed targets (default: recorded)\n"
+            "  --padding-stationary UU  HitScanPaddingStationary (default: recorded)\n"
+            "  --rewind-offset-ms MS    add MS to every rewind\n"
+            "  --rewind-scale S         multiply every rewind by S\n"
+            "  --repeat N               run each pawn pass N times (timing)\n"
+            "  --verbose                print every shot whose result differs\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FOptions Options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+        const bool bHasValue = i + 1 < argc;
+        if (Arg == "--padding" && bHasValue)
+        {
+            Options.PaddingMoving = (float)std::atof(argv[++i]);
+        }
+        else if (Arg == "--padding-stationary" && bHasValue)
+        {
+            Options.PaddingStationary = (float)std::atof(argv[++i]);
+        }
+        else if (Arg == "--rewind-offset-ms" && bHasValue)
+        {
+            Options.RewindOffsetMs = (float)std::atof(argv[++i]);
+        }
+        else if (Arg == "--rewind-scale" && bHasValue)
+        {
+            Options.RewindScale = (float)std::atof(argv[++i]);
+        }
+        else if (Arg == "--repeat" && bHasValue)
+        {
+            Options.Repeat = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (Arg == "--verbose")
+        {
+            Options.bVerbose = true;
+        }
+        else if (Arg == "-h" || Arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+        {
+            Options.File = Arg;
+        }
+    }
+    if (Options.File.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const int Fd = open(Options.File.c_str(), O_RDONLY);
+    struct stat St;
+    if (Fd < 0 || fstat(Fd, &St) != 0 || St.st_size == 0)
+    {
+        std::fprintf(stderr, "%s: cannot open\n", Options.File.c_str());
+        return 1;
+    }
+    void* Mapped = mmap(nullptr, (size_t)St.st_size, PROT_READ, MAP_PRIVATE, Fd, 0);
+    close(Fd);
+    if (Mapped == MAP_FAILED)
+    {
+        std::fprintf(stderr, "%s: mmap failed\n", Options.File.c_str());
+        return 1;
+    }
+
+    FReplayStats Stats;
+    const bool bOk = Replay(static_cast<const uint8_t*>(Mapped), (size_t)St.st_size, Options, Stats);
+    munmap(Mapped, (size_t)St.st_size);
+    if (!bOk)
+    {
+        return 1;
+    }
+    PrintReport(Stats, Options);
+    return 0;
+}